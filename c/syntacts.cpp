@@ -8,6 +8,8 @@ using namespace tact;
 std::unordered_map<Handle, Signal> g_sigs;
 std::unordered_map<Handle, std::unique_ptr<Session>> g_sessions;
 std::unordered_map<Handle, std::unique_ptr<Spatializer>> g_spats;
+std::unordered_map<Handle, std::unique_ptr<Client>> g_clients;
+std::unordered_map<Handle, std::unique_ptr<UdpClient>> g_udpClients;
 
 struct Finalizer {
     ~Finalizer()
@@ -15,6 +17,8 @@ struct Finalizer {
         g_sigs.clear();
         g_sessions.clear(); 
         g_spats.clear();
+        g_clients.clear();
+        g_udpClients.clear();
     }
 };
 
@@ -101,6 +105,16 @@ bool Session_isOpen(Handle session) {
     return static_cast<Session*>(session)->isOpen();
 }
 
+int Session_setRealTime(Handle session, int scheduling, int priority, int* cpus, int cpuCount, bool flushDenormals, bool lockMemory) {
+    RealTime rt;
+    rt.scheduling = static_cast<Scheduling>(scheduling);
+    rt.priority = priority;
+    rt.cpus = std::vector<int>(cpus, cpus + cpuCount);
+    rt.flushDenormals = flushDenormals;
+    rt.lockMemory = lockMemory;
+    return static_cast<Session*>(session)->setRealTime(rt);
+}
+
 int Session_play(Handle session, int channel, Handle signal) {
     return static_cast<Session*>(session)->play(channel, g_sigs.at(signal));
 }
@@ -109,6 +123,10 @@ int Session_playAll(Handle session, Handle signal) {
     return static_cast<Session*>(session)->playAll(g_sigs.at(signal));
 }
 
+int Session_prepare(Handle session, Handle signal) {
+    return static_cast<Session*>(session)->prepare(g_sigs.at(signal));
+}
+
 int Session_stop(Handle session, int channel) {
     return static_cast<Session*>(session)->stop(channel);
 }
@@ -141,6 +159,31 @@ bool Session_isPaused(Handle session, int channel) {
     return static_cast<Session*>(session)->isPaused(channel);
 }
 
+bool Session_pollEvent(Handle session, int* type, int* channel, int* voice, double* time) {
+    Event event;
+    if (!static_cast<Session*>(session)->pollEvent(event))
+        return false;
+    *type    = static_cast<int>(event.type);
+    *channel = event.channel;
+    *voice   = event.voice;
+    *time    = event.time;
+    return true;
+}
+
+void Session_setEventCallback(Handle session, EventCallback callback) {
+    if (callback == nullptr) {
+        static_cast<Session*>(session)->setEventCallback(nullptr);
+        return;
+    }
+    static_cast<Session*>(session)->setEventCallback([callback](const Event& e) {
+        callback(static_cast<int>(e.type), e.channel, e.voice, e.time);
+    });
+}
+
+unsigned long long Session_getDroppedEvents(Handle session) {
+    return static_cast<Session*>(session)->getDroppedEvents();
+}
+
 int Session_setVolume(Handle session, int channel, double volume) {
     return static_cast<Session*>(session)->setVolume(channel, volume);
 }
@@ -173,6 +216,46 @@ double Session_getCpuLoad(Handle session) {
     return static_cast<Session*>(session)->getCpuLoad();
 }
 
+double Session_getTime(Handle session) {
+    return static_cast<Session*>(session)->getTime();
+}
+
+int Session_startRecording(Handle session, const char* filePath) {
+    return static_cast<Session*>(session)->startRecording(filePath);
+}
+
+int Session_stopRecording(Handle session) {
+    return static_cast<Session*>(session)->stopRecording();
+}
+
+bool Session_isRecording(Handle session) {
+    return static_cast<Session*>(session)->isRecording();
+}
+
+int Session_playAt(Handle session, int channel, Handle signal, double time) {
+    return static_cast<Session*>(session)->play(channel, g_sigs.at(signal), time);
+}
+
+int Session_stopAt(Handle session, int channel, double time) {
+    return static_cast<Session*>(session)->stop(channel, time);
+}
+
+int Session_pauseAt(Handle session, int channel, double time) {
+    return static_cast<Session*>(session)->pause(channel, time);
+}
+
+int Session_resumeAt(Handle session, int channel, double time) {
+    return static_cast<Session*>(session)->resume(channel, time);
+}
+
+int Session_setVolumeAt(Handle session, int channel, double volume, double time) {
+    return static_cast<Session*>(session)->setVolume(channel, volume, time);
+}
+
+int Session_setPitchAt(Handle session, int channel, double pitch, double time) {
+    return static_cast<Session*>(session)->setPitch(channel, pitch, time);
+}
+
 int Session_getCurrentDevice(Handle session) {
     return static_cast<Session*>(session)->getCurrentDevice().index;
 }
@@ -260,6 +343,136 @@ int  Device_defaultSampleRate(Handle session, int d) {
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+Handle Client_create() {
+    std::unique_ptr client = std::make_unique<Client>();
+    Handle h = static_cast<Handle>(client.get());
+    g_clients.emplace(h, std::move(client));
+    return h;
+}
+
+void Client_delete(Handle client) {
+    g_clients.erase(client);
+}
+
+bool Client_valid(Handle client) {
+    return g_clients.count(client) > 0;
+}
+
+int Client_connect(Handle client, const char* name) {
+    return static_cast<Client*>(client)->connect(name);
+}
+
+void Client_disconnect(Handle client) {
+    static_cast<Client*>(client)->disconnect();
+}
+
+bool Client_isConnected(Handle client) {
+    return static_cast<Client*>(client)->isConnected();
+}
+
+int Client_play(Handle client, int channel, Handle signal) {
+    return static_cast<Client*>(client)->play(channel, g_sigs.at(signal));
+}
+
+int Client_playLibrary(Handle client, int channel, const char* name) {
+    return static_cast<Client*>(client)->playLibrary(channel, name);
+}
+
+int Client_stop(Handle client, int channel) {
+    return static_cast<Client*>(client)->stop(channel);
+}
+
+int Client_stopAll(Handle client) {
+    return static_cast<Client*>(client)->stopAll();
+}
+
+int Client_pause(Handle client, int channel) {
+    return static_cast<Client*>(client)->pause(channel);
+}
+
+int Client_resume(Handle client, int channel) {
+    return static_cast<Client*>(client)->resume(channel);
+}
+
+int Client_setVolume(Handle client, int channel, double volume) {
+    return static_cast<Client*>(client)->setVolume(channel, volume);
+}
+
+int Client_setPitch(Handle client, int channel, double pitch) {
+    return static_cast<Client*>(client)->setPitch(channel, pitch);
+}
+
+int Client_getChannelCount(Handle client) {
+    return static_cast<Client*>(client)->getChannelCount();
+}
+
+double Client_getSampleRate(Handle client) {
+    return static_cast<Client*>(client)->getSampleRate();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Handle UdpClient_create() {
+    std::unique_ptr client = std::make_unique<UdpClient>();
+    Handle h = static_cast<Handle>(client.get());
+    g_udpClients.emplace(h, std::move(client));
+    return h;
+}
+
+void UdpClient_delete(Handle client) {
+    g_udpClients.erase(client);
+}
+
+bool UdpClient_valid(Handle client) {
+    return g_udpClients.count(client) > 0;
+}
+
+int UdpClient_connect(Handle client, const char* address, int port) {
+    return static_cast<UdpClient*>(client)->connect(address, port);
+}
+
+void UdpClient_setTime(Handle client, double time) {
+    static_cast<UdpClient*>(client)->setTime(time);
+}
+
+int UdpClient_play(Handle client, int channel, Handle signal) {
+    return static_cast<UdpClient*>(client)->play(channel, g_sigs.at(signal));
+}
+
+int UdpClient_playLibrary(Handle client, int channel, const char* name) {
+    return static_cast<UdpClient*>(client)->playLibrary(channel, name);
+}
+
+int UdpClient_stop(Handle client, int channel) {
+    return static_cast<UdpClient*>(client)->stop(channel);
+}
+
+int UdpClient_stopAll(Handle client) {
+    return static_cast<UdpClient*>(client)->stopAll();
+}
+
+int UdpClient_setVolume(Handle client, int channel, double volume) {
+    return static_cast<UdpClient*>(client)->setVolume(channel, volume);
+}
+
+int UdpClient_setPitch(Handle client, int channel, double pitch) {
+    return static_cast<UdpClient*>(client)->setPitch(channel, pitch);
+}
+
+int UdpClient_setTarget(Handle client, int spatializer, double x, double y) {
+    return static_cast<UdpClient*>(client)->setTarget(spatializer, x, y);
+}
+
+int UdpClient_send(Handle client) {
+    return static_cast<UdpClient*>(client)->send();
+}
+
+double UdpClient_now() {
+    return UdpClient::now();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 Handle Spatializer_create(Handle session) {
@@ -362,6 +575,49 @@ void Spatializer_getWrap(Handle spat, double* x, double* y) {
     *y = wr.y;
 }
 
+void Spatializer_setCalibration(Handle spat, int channel, double gain) {
+    static_cast<Spatializer*>(spat)->setCalibration(channel, gain);
+}
+
+double Spatializer_getCalibration(Handle spat, int channel) {
+    return static_cast<Spatializer*>(spat)->getCalibration(channel);
+}
+
+void Spatializer_setKernel(Handle spat, double x, double y, double z) {
+    static_cast<Spatializer*>(spat)->setKernel(x, y, z);
+}
+
+void Spatializer_getKernel(Handle spat, double* x, double* y, double* z) {
+    auto k = static_cast<Spatializer*>(spat)->getKernel();
+    *x = k.x;
+    *y = k.y;
+    *z = k.z;
+}
+
+void Spatializer_setNearest(Handle spat, int k) {
+    static_cast<Spatializer*>(spat)->setNearest(k);
+}
+
+int Spatializer_getNearest(Handle spat) {
+    return static_cast<Spatializer*>(spat)->getNearest();
+}
+
+void Spatializer_setTrajectory1(Handle spat, Handle x, Handle y) {
+    static_cast<Spatializer*>(spat)->setTrajectory(g_sigs.at(x), g_sigs.at(y));
+}
+
+void Spatializer_setTrajectory2(Handle spat, Handle x, Handle y, Handle r) {
+    static_cast<Spatializer*>(spat)->setTrajectory(g_sigs.at(x), g_sigs.at(y), g_sigs.at(r));
+}
+
+void Spatializer_clearTrajectory(Handle spat) {
+    static_cast<Spatializer*>(spat)->clearTrajectory();
+}
+
+bool Spatializer_hasTrajectory(Handle spat) {
+    return static_cast<Spatializer*>(spat)->hasTrajectory();
+}
+
 bool Spatializer_createGrid(Handle spat, int rows, int cols) {
     return static_cast<Spatializer*>(spat)->createGrid(rows,cols);
 }
@@ -416,6 +672,46 @@ void Spatializer_update(Handle spat) {
     static_cast<Spatializer*>(spat)->update();
 }
 
+int Spatializer_addSource(Handle spat, Handle signal, double x, double y) {
+    return static_cast<Spatializer*>(spat)->addSource(g_sigs.at(signal), x, y);
+}
+
+void Spatializer_playSource(Handle spat, int source, Handle signal) {
+    static_cast<Spatializer*>(spat)->playSource(source, g_sigs.at(signal));
+}
+
+void Spatializer_removeSource(Handle spat, int source) {
+    static_cast<Spatializer*>(spat)->removeSource(source);
+}
+
+void Spatializer_setSourcePosition(Handle spat, int source, double x, double y) {
+    static_cast<Spatializer*>(spat)->setSourcePosition(source, x, y);
+}
+
+void Spatializer_setSourceRadius(Handle spat, int source, double r) {
+    static_cast<Spatializer*>(spat)->setSourceRadius(source, r);
+}
+
+void Spatializer_setSourceVolume(Handle spat, int source, double volume) {
+    static_cast<Spatializer*>(spat)->setSourceVolume(source, volume);
+}
+
+void Spatializer_setSourceTrajectory1(Handle spat, int source, Handle x, Handle y) {
+    static_cast<Spatializer*>(spat)->setSourceTrajectory(source, g_sigs.at(x), g_sigs.at(y));
+}
+
+void Spatializer_setSourceTrajectory2(Handle spat, int source, Handle x, Handle y, Handle r) {
+    static_cast<Spatializer*>(spat)->setSourceTrajectory(source, g_sigs.at(x), g_sigs.at(y), g_sigs.at(r));
+}
+
+void Spatializer_clearSourceTrajectory(Handle spat, int source) {
+    static_cast<Spatializer*>(spat)->clearSourceTrajectory(source);
+}
+
+int Spatializer_getSourceCount(Handle spat) {
+    return static_cast<Spatializer*>(spat)->getSourceCount();
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -435,6 +731,10 @@ double Signal_length(Handle signal) {
     return g_sigs.at(signal).length();
 }
 
+double Signal_peak(Handle signal) {
+    return g_sigs.at(signal).peak();
+}
+
 void Signal_setGain(Handle signal, double gain) {
     g_sigs.at(signal).gain = gain;
 }
@@ -597,10 +897,36 @@ Handle Noise_create() {
     return store(Noise());
 }
 
+Handle Noise_createSeeded(unsigned long long seed) {
+    return store(Noise(seed));
+}
+
+Handle PinkNoise_create(unsigned long long seed) {
+    return store(PinkNoise(seed));
+}
+
+Handle BrownNoise_create(unsigned long long seed) {
+    return store(BrownNoise(seed));
+}
+
+Handle BandNoise_create(double low, double high, unsigned long long seed) {
+    return store(BandNoise(low, high, seed));
+}
+
 Handle Expression_create(const char* expr) {
     return store(Expression(expr));
 }
 
+bool Expression_setVariable(Handle expr, const char* name, double value) {
+    Expression& e = *(Expression*)g_sigs.at(expr).get();
+    return e.setVariable(name, value);
+}
+
+double Expression_getVariable(Handle expr, const char* name) {
+    Expression& e = *(Expression*)g_sigs.at(expr).get();
+    return e.getVariable(name);
+}
+
 Handle Samples_create(float* samples, int nSamples, double sampleRate) {
     std::vector<float> vsamples(samples, samples + nSamples);
     return store(Samples(vsamples, sampleRate));
@@ -620,6 +946,10 @@ Handle Reverser_create(Handle signal) {
     return store(Reverser(g_sigs.at(signal)));
 }
 
+Handle ControlRate_create(Handle signal, double rate) {
+    return store(ControlRate(g_sigs.at(signal), rate));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 Handle Envelope_create(double duration, double amp) {
@@ -712,6 +1042,30 @@ Handle Pwm_create(double frequency, double dutyCycle) {
     return store(Pwm(frequency, dutyCycle));
 }
 
+Handle Chirp_create(double initial, double rate) {
+    return store(Chirp(initial, rate));
+}
+
+Handle FmSine_create(double frequency, double modulation, double index) {
+    return store(FmSine(frequency, modulation, index));
+}
+
+Handle Wavetable_create1(int shape, double hertz) {
+    return store(Wavetable(static_cast<Wavetable::Shape>(shape), hertz));
+}
+
+Handle Wavetable_create2(int shape, Handle x) {
+    return store(Wavetable(static_cast<Wavetable::Shape>(shape), g_sigs.at(x)));
+}
+
+Handle Wavetable_create3(Handle cycle, double hertz) {
+    return store(Wavetable(g_sigs.at(cycle), hertz));
+}
+
+Handle Wavetable_create4(Handle cycle, Handle x) {
+    return store(Wavetable(g_sigs.at(cycle), g_sigs.at(x)));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 bool Library_saveSignal(Handle signal, const char* name) {
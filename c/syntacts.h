@@ -16,6 +16,7 @@ extern "C" {
 #endif
 
 typedef void* Handle;
+typedef void (*EventCallback)(int type, int channel, int voice, double time);
 
 ///////////////////////////////////////////////////////////////////////////////
 // SYNTACTS CONFIG
@@ -41,9 +42,11 @@ EXPORT int Session_open4(Handle session, int api);
 EXPORT int Session_open5(Handle session, char* name, int api);
 EXPORT int Session_close(Handle session);
 EXPORT bool Session_isOpen(Handle session);
+EXPORT int Session_setRealTime(Handle session, int scheduling, int priority, int* cpus, int cpuCount, bool flushDenormals, bool lockMemory);
 
 EXPORT int Session_play(Handle session, int channel, Handle signal);
 EXPORT int Session_playAll(Handle session, Handle signal);
+EXPORT int Session_prepare(Handle session, Handle signal);
 EXPORT int Session_stop(Handle session, int channel);
 EXPORT int Session_stopAll(Handle session);
 EXPORT int Session_pause(Handle session, int channel);
@@ -52,6 +55,9 @@ EXPORT int Session_resume(Handle session, int channel);
 EXPORT int Session_resumeAll(Handle session);
 EXPORT bool Session_isPlaying(Handle session, int channel);
 EXPORT bool Session_isPaused(Handle session, int channel);
+EXPORT bool Session_pollEvent(Handle session, int* type, int* channel, int* voice, double* time);
+EXPORT void Session_setEventCallback(Handle session, EventCallback callback);
+EXPORT unsigned long long Session_getDroppedEvents(Handle session);
 
 EXPORT int Session_setVolume(Handle session, int channel, double volume);
 EXPORT double Session_getVolume(Handle session, int channel);
@@ -61,6 +67,16 @@ EXPORT double Session_getLevel(Handle session, int channel);
 EXPORT int Session_getChannelCount(Handle session);
 EXPORT double Session_getSampleRate(Handle session);
 EXPORT double Session_getCpuLoad(Handle session);
+EXPORT double Session_getTime(Handle session);
+EXPORT int Session_startRecording(Handle session, const char* filePath);
+EXPORT int Session_stopRecording(Handle session);
+EXPORT bool Session_isRecording(Handle session);
+EXPORT int Session_playAt(Handle session, int channel, Handle signal, double time);
+EXPORT int Session_stopAt(Handle session, int channel, double time);
+EXPORT int Session_pauseAt(Handle session, int channel, double time);
+EXPORT int Session_resumeAt(Handle session, int channel, double time);
+EXPORT int Session_setVolumeAt(Handle session, int channel, double volume, double time);
+EXPORT int Session_setPitchAt(Handle session, int channel, double pitch, double time);
 
 EXPORT int Session_getCurrentDevice(Handle session);
 EXPORT int Session_getDefaultDevice(Handle session);
@@ -85,6 +101,46 @@ EXPORT int  Device_sampleRatesCount(Handle session, int d);
 EXPORT void Device_sampleRates(Handle session, int d, int* sampleRates);
 EXPORT int  Device_defaultSampleRate(Handle session, int d);
 
+///////////////////////////////////////////////////////////////////////////////
+// CLIENT
+///////////////////////////////////////////////////////////////////////////////
+
+EXPORT Handle Client_create();
+EXPORT void Client_delete(Handle client);
+EXPORT bool Client_valid(Handle client);
+EXPORT int Client_connect(Handle client, const char* name);
+EXPORT void Client_disconnect(Handle client);
+EXPORT bool Client_isConnected(Handle client);
+EXPORT int Client_play(Handle client, int channel, Handle signal);
+EXPORT int Client_playLibrary(Handle client, int channel, const char* name);
+EXPORT int Client_stop(Handle client, int channel);
+EXPORT int Client_stopAll(Handle client);
+EXPORT int Client_pause(Handle client, int channel);
+EXPORT int Client_resume(Handle client, int channel);
+EXPORT int Client_setVolume(Handle client, int channel, double volume);
+EXPORT int Client_setPitch(Handle client, int channel, double pitch);
+EXPORT int Client_getChannelCount(Handle client);
+EXPORT double Client_getSampleRate(Handle client);
+
+///////////////////////////////////////////////////////////////////////////////
+// UDP CLIENT
+///////////////////////////////////////////////////////////////////////////////
+
+EXPORT Handle UdpClient_create();
+EXPORT void UdpClient_delete(Handle client);
+EXPORT bool UdpClient_valid(Handle client);
+EXPORT int UdpClient_connect(Handle client, const char* address, int port);
+EXPORT void UdpClient_setTime(Handle client, double time);
+EXPORT int UdpClient_play(Handle client, int channel, Handle signal);
+EXPORT int UdpClient_playLibrary(Handle client, int channel, const char* name);
+EXPORT int UdpClient_stop(Handle client, int channel);
+EXPORT int UdpClient_stopAll(Handle client);
+EXPORT int UdpClient_setVolume(Handle client, int channel, double volume);
+EXPORT int UdpClient_setPitch(Handle client, int channel, double pitch);
+EXPORT int UdpClient_setTarget(Handle client, int spatializer, double x, double y);
+EXPORT int UdpClient_send(Handle client);
+EXPORT double UdpClient_now();
+
 ///////////////////////////////////////////////////////////////////////////////
 // SPATIALIZER
 ///////////////////////////////////////////////////////////////////////////////
@@ -104,6 +160,16 @@ EXPORT void Spatializer_setRollOff(Handle spat, int type);
 EXPORT int Spatializer_getRollOff(Handle spat);
 EXPORT void Spatializer_setWrap(Handle spat, double x, double y);
 EXPORT void Spatializer_getWrap(Handle spat, double* x, double* y);
+EXPORT void Spatializer_setCalibration(Handle spat, int channel, double gain);
+EXPORT double Spatializer_getCalibration(Handle spat, int channel);
+EXPORT void Spatializer_setKernel(Handle spat, double x, double y, double z);
+EXPORT void Spatializer_getKernel(Handle spat, double* x, double* y, double* z);
+EXPORT void Spatializer_setNearest(Handle spat, int k);
+EXPORT int Spatializer_getNearest(Handle spat);
+EXPORT void Spatializer_setTrajectory1(Handle spat, Handle x, Handle y);
+EXPORT void Spatializer_setTrajectory2(Handle spat, Handle x, Handle y, Handle r);
+EXPORT void Spatializer_clearTrajectory(Handle spat);
+EXPORT bool Spatializer_hasTrajectory(Handle spat);
 
 EXPORT bool Spatializer_createGrid(Handle spat, int rows, int cols);
 EXPORT void Spatializer_clear(Handle spat);
@@ -118,6 +184,17 @@ EXPORT double Spatializer_getVolume(Handle spat);
 EXPORT void Spatializer_setPitch(Handle spat, double pitch);
 EXPORT double Spatializer_getPitch(Handle spat);
 
+EXPORT int Spatializer_addSource(Handle spat, Handle signal, double x, double y);
+EXPORT void Spatializer_playSource(Handle spat, int source, Handle signal);
+EXPORT void Spatializer_removeSource(Handle spat, int source);
+EXPORT void Spatializer_setSourcePosition(Handle spat, int source, double x, double y);
+EXPORT void Spatializer_setSourceRadius(Handle spat, int source, double r);
+EXPORT void Spatializer_setSourceVolume(Handle spat, int source, double volume);
+EXPORT void Spatializer_setSourceTrajectory1(Handle spat, int source, Handle x, Handle y);
+EXPORT void Spatializer_setSourceTrajectory2(Handle spat, int source, Handle x, Handle y, Handle r);
+EXPORT void Spatializer_clearSourceTrajectory(Handle spat, int source);
+EXPORT int Spatializer_getSourceCount(Handle spat);
+
 EXPORT void Spatializer_autoUpdate(Handle spat, bool enable);
 EXPORT void Spatializer_update(Handle spat);
 
@@ -131,6 +208,7 @@ EXPORT void Signal_delete(Handle signal);
 EXPORT bool Signal_valid(Handle signal);
 EXPORT double Signal_sample(Handle signal, double t);
 EXPORT double Signal_length(Handle signal);
+EXPORT double Signal_peak(Handle signal);
 EXPORT void Signal_setGain(Handle signal, double gain);
 EXPORT double Signal_getGain(Handle signal);
 EXPORT void Signal_setBias(Handle signal, double bias);
@@ -185,7 +263,13 @@ EXPORT Handle Scalar_create(double value);
 EXPORT Handle Ramp_create1(double initial, double rate);
 EXPORT Handle Ramp_create2(double initial, double final, double duration);
 EXPORT Handle Noise_create();
+EXPORT Handle Noise_createSeeded(unsigned long long seed);
+EXPORT Handle PinkNoise_create(unsigned long long seed);
+EXPORT Handle BrownNoise_create(unsigned long long seed);
+EXPORT Handle BandNoise_create(double low, double high, unsigned long long seed);
 EXPORT Handle Expression_create(const char* expr);
+EXPORT bool Expression_setVariable(Handle expr, const char* name, double value);
+EXPORT double Expression_getVariable(Handle expr, const char* name);
 EXPORT Handle Samples_create(float* samples, int nSamples, double sampleRate);
 
 // TODO: PolyBezier
@@ -197,6 +281,7 @@ EXPORT Handle Samples_create(float* samples, int nSamples, double sampleRate);
 EXPORT Handle Repeater_create(Handle signal, int repetitions, double delay);
 EXPORT Handle Stretcher_create(Handle signal, double factor);
 EXPORT Handle Reverser_create(Handle signal);
+EXPORT Handle ControlRate_create(Handle signal, double rate);
 
 ///////////////////////////////////////////////////////////////////////////////
 // ENVELOPE
@@ -235,6 +320,13 @@ EXPORT Handle Triangle_create3(double initial, double rate);
 EXPORT Handle Triangle_create4(double hertz, Handle modulation, double index);
 
 EXPORT Handle Pwm_create(double frequency, double dutyCycle);
+EXPORT Handle Chirp_create(double initial, double rate);
+EXPORT Handle FmSine_create(double frequency, double modulation, double index);
+
+EXPORT Handle Wavetable_create1(int shape, double hertz);
+EXPORT Handle Wavetable_create2(int shape, Handle x);
+EXPORT Handle Wavetable_create3(Handle cycle, double hertz);
+EXPORT Handle Wavetable_create4(Handle cycle, Handle x);
 
 ///////////////////////////////////////////////////////////////////////////////
 // LIBRARY
@@ -24,6 +24,12 @@ std::shared_ptr<Node> makeNode(PItem id) {
         return std::make_shared<RampNode>();
     if (id == PItem::Noise)
         return std::make_shared<NoiseNode>();
+    if (id == PItem::PinkNoise)
+        return std::make_shared<PinkNoiseNode>();
+    if (id == PItem::BrownNoise)
+        return std::make_shared<BrownNoiseNode>();
+    if (id == PItem::BandNoise)
+        return std::make_shared<BandNoiseNode>();
     if (id == PItem::Expression)
         return std::make_shared<ExpressionNode>();
     if (id == PItem::Sum)
@@ -77,12 +83,33 @@ std::shared_ptr<Node> makeOscNode(const tact::Signal& sig, int idx) {
         node->sig = sig;
         return node;
     }
+    else if (osc->x.template isType<tact::ChirpPhase>()) {
+        auto x = osc->x.template getAs<tact::ChirpPhase>();
+        auto node = std::make_shared<ChirpNode>();
+        node->f = x->initial;
+        node->r = x->rate;
+        node->ftype = idx;
+        return node;
+    }
+    else if (osc->x.template isType<tact::FmPhase>()) {
+        auto x = osc->x.template getAs<tact::FmPhase>();
+        if (x->modulation.template isType<tact::Sine>()) {
+            auto node = std::make_shared<FmNode>();
+            node->f = x->frequency;
+            node->index = x->index;
+            node->ftype = idx;
+            node->m = x->modulation.template getAs<tact::Sine>()->x.gain / tact::TWO_PI;
+            return node;
+        }
+    }
+    // phase trees saved before ChirpPhase and FmPhase existed
     else if (osc->x.template isType<tact::Product>()) {
         auto x = osc->x.template getAs<tact::Product>();
         if (x->lhs.template isType<tact::Time>() && x->rhs.template isType<tact::Time>()) {
             auto node = std::make_shared<ChirpNode>();
             node->f = x->lhs.bias / tact::TWO_PI;
             node->r = x->lhs.gain / tact::PI;
+            node->ftype = idx;
             return node;
         }
     }
@@ -159,12 +186,33 @@ std::shared_ptr<Node> makeNode(const tact::Signal& sig) {
         return std::make_shared<RampNode>(sig);  
     else if (sig.isType<tact::Noise>())
         return std::make_shared<NoiseNode>(sig);
+    else if (sig.isType<tact::PinkNoise>())
+        return std::make_shared<PinkNoiseNode>(sig);
+    else if (sig.isType<tact::BrownNoise>())
+        return std::make_shared<BrownNoiseNode>(sig);
+    else if (sig.isType<tact::BandNoise>())
+        return std::make_shared<BandNoiseNode>(sig);
     else if (sig.isType<tact::Expression>()) 
         return std::make_shared<ExpressionNode>(sig);    
     else if (sig.isType<tact::PolyBezier>())
         return std::make_shared<PolyBezierNode>(sig);
     else if (sig.isType<tact::Samples>()) 
         return std::make_shared<SamplesNode>(sig);
+    else if (sig.isType<tact::Chirp>()) {
+        auto chirp = sig.getAs<tact::Chirp>();
+        auto node = std::make_shared<ChirpNode>();
+        node->f = chirp->initial;
+        node->r = chirp->rate;
+        return node;
+    }
+    else if (sig.isType<tact::FmSine>()) {
+        auto fm = sig.getAs<tact::FmSine>();
+        auto node = std::make_shared<FmNode>();
+        node->f = fm->frequency;
+        node->m = fm->modulation;
+        node->index = fm->index;
+        return node;
+    }
     else if (sig.isType<tact::Sum>()) {
         auto node = std::make_shared<SumNode>();
         if (recurseSum(node, sig))
@@ -179,6 +227,8 @@ std::shared_ptr<Node> makeNode(const tact::Signal& sig) {
         auto seq = sig.getAs<tact::Sequence>();
         return std::make_shared<SequencerNode>(*seq);
     }
+    else if (sig.isType<tact::SequenceRef>())
+        return std::make_shared<SequencerNode>(sig.getAs<tact::SequenceRef>()->get());
     else if (sig.isType<tact::Sine>())
         return makeOscNode<tact::Sine>(sig, 0);    
     else if (sig.isType<tact::Square>())
@@ -490,6 +540,8 @@ void ChirpNode::update()
 
 tact::Signal ChirpNode::signal()
 {
+    if (ftype == 0)
+        return tact::Chirp(f, r);
     return makeOsc(ftype, f, r);
 }
 
@@ -516,6 +568,8 @@ void FmNode::update()
 
 tact::Signal FmNode::signal()
 {
+    if (ftype == 0)
+        return tact::FmSine(f, m, index);
     return makeOsc(ftype, f, tact::Sine(m), index);
 }
 
@@ -577,6 +631,18 @@ void ExpressionNode::update()
             ok = true;
         }
     }
+    auto cast = (tact::Expression *)sig.get();
+    for (auto& v : cast->getVariables()) {
+        double value = v.second;
+        if (ImGui::DragDouble(v.first.c_str(), &value, 0.01f))
+            cast->setVariable(v.first, value);
+    }
+    ImGui::SetNextItemWidth(160);
+    bool add = ImGui::InputTextWithHint("##Variable", "variable", varBuffer, 32, ImGuiInputTextFlags_CharsNoBlank | ImGuiInputTextFlags_EnterReturnsTrue);
+    ImGui::SameLine();
+    add = ImGui::Button(ICON_FA_PLUS) || add;
+    if (add && varBuffer[0] != '\0' && cast->setVariable(varBuffer, cast->getVariable(varBuffer)))
+        varBuffer[0] = '\0';
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -623,16 +689,23 @@ void PolyBezierNode::update()
 void PolyBezierNode::sync() {
     auto cast = (tact::PolyBezier *)sig.get();
     int points = pb.pointCount();
+    bool changed = cast->points.size() != points;
     cast->points.resize(points);
+    auto assign = [&](tact::PolyBezier::Point& p, const ImVec2& v) {
+        changed = changed || p.t != v.x || p.y != v.y;
+        p = {v.x, v.y};
+    };
     for (int i = 0; i < points; ++i)
     {
         ImVec2 cpL, pos, cpR;
         pb.getPoint(i, &cpL, &pos, &cpR);
-        cast->points[i].cpL = {cpL.x, cpL.y};
-        cast->points[i].p = {pos.x, pos.y};
-        cast->points[i].cpR = {cpR.x, cpR.y};
+        assign(cast->points[i].cpL, cpL);
+        assign(cast->points[i].p, pos);
+        assign(cast->points[i].cpR, cpR);
     }
-    cast->solve();
+    // the editor syncs every frame, so only re-flatten when a point moved
+    if (changed)
+        cast->solve();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -641,6 +714,15 @@ void SamplesNode::update() {
     auto samples = sig.getAs<tact::Samples>();
     ImGui::Text("Sample Count: %d", samples->sampleCount());
     ImGui::Text("Sample Rate:  %.0f Hz", samples->sampleRate());
+    static const char* interpNames[] = {"Nearest", "Linear", "Cubic", "Sinc"};
+    int interp = static_cast<int>(samples->getInterpolation());
+    if (ImGui::BeginCombo("Interpolation", interpNames[interp])) {
+        for (int i = 0; i < 4; ++i) {
+            if (ImGui::Selectable(interpNames[i], i == interp))
+                samples->setInterpolation(static_cast<tact::Samples::Interpolation>(i));
+        }
+        ImGui::EndCombo();
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -741,23 +823,16 @@ static const tact::Curve CURVES[] = {
 void KeyedEnvelopeNode::update() {
     auto cast = sig.getAs<tact::KeyedEnvelope>();
     Ts.clear(); As.clear(); Cs.clear();
-    int key_count = cast->keys.size();
-    int i = 0;
-    for (auto it = cast->keys.begin(); it != cast->keys.end(); ++it) {
-        double t       = it->first;
-        double a       = it->second.first;
-        tact::Curve c  = it->second.second;
-        bool first_key = it == cast->keys.begin();
-        bool last_key  = std::next(it) == cast->keys.end();
-        double tprev, tnext;
-        if (first_key)
-            tprev = 0;
-        else 
-            tprev = std::prev(it)->first;
-        if (last_key)
-            tnext = 0;
-        else
-            tnext = std::next(it)->first;   
+    int key_count = cast->keyCount();
+    for (int i = 0; i < key_count; ++i) {
+        auto& key      = cast->getKey(i);
+        double t       = key.t;
+        double a       = key.amplitude;
+        tact::Curve c  = key.curve;
+        bool first_key = i == 0;
+        bool last_key  = i == key_count - 1;
+        double tprev = first_key ? 0 : cast->getKey(i - 1).t;
+        double tnext = last_key  ? 0 : cast->getKey(i + 1).t;
         double tmin = first_key ? 0 : tprev + 0.001;
         double tmax = last_key  ? t + 1000 : tnext - 0.001; 
         ImGui::PushID(i);
@@ -794,9 +869,8 @@ void KeyedEnvelopeNode::update() {
             Cs.push_back(tact::Curves::Linear());
         }       
         ImGui::PopID();
-        i++;
     }
-    cast->keys.clear();
+    cast->clearKeys();
     for (int i = 0; i < Ts.size(); ++i) 
         cast->addKey(Ts[i], As[i], Cs[i]);    
 }
@@ -807,18 +881,16 @@ void ASRNode::update()
 {
     static const float minDur = 0.001f;
     auto cast = (tact::ASR *)sig.get();
-    auto it = cast->keys.begin();
-    it++;
-    auto &a = *(it++);
-    auto &s = *(it++);
-    auto &r = *(it++);
+    auto &a = cast->getKey(1);
+    auto &s = cast->getKey(2);
+    auto &r = cast->getKey(3);
 
     float asr[3];
-    asr[0] = a.first;
-    asr[1] = s.first - a.first;
-    asr[2] = r.first - s.first;
+    asr[0] = a.t;
+    asr[1] = s.t - a.t;
+    asr[2] = r.t - s.t;
 
-    float amp = a.second.first;
+    float amp = a.amplitude;
 
     bool changed = false;
     if (ImGui::DragFloat3("Durations", asr, 0.001f, minDur, 1.0f, "%0.3f s"))
@@ -842,21 +914,19 @@ void ADSRNode::update()
 {
     static const float minDur = 0.001f;
 
-    auto cast = (tact::ASR *)sig.get();
-    auto it = cast->keys.begin();
-    it++;
-    auto &a = *(it++);
-    auto &d = *(it++);
-    auto &s = *(it++);
-    auto &r = *(it++);
+    auto cast = (tact::ADSR *)sig.get();
+    auto &a = cast->getKey(1);
+    auto &d = cast->getKey(2);
+    auto &s = cast->getKey(3);
+    auto &r = cast->getKey(4);
     float adsr[4];
-    adsr[0] = a.first;
-    adsr[1] = d.first - a.first;
-    adsr[2] = s.first - d.first;
-    adsr[3] = r.first - s.first;
+    adsr[0] = a.t;
+    adsr[1] = d.t - a.t;
+    adsr[2] = s.t - d.t;
+    adsr[3] = r.t - s.t;
     float amp[2];
-    amp[0] = a.second.first;
-    amp[1] = d.second.first;
+    amp[0] = a.amplitude;
+    amp[1] = d.amplitude;
     bool changed = false;
     if (ImGui::DragFloat4("Durations", adsr, 0.001f, minDur, 1, "%0.3f s"))
         changed = true;
@@ -899,16 +969,45 @@ void SignalEnvelopeNode::update()
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void NoiseNode::update()
+/// Gain, bias, and seed controls shared by the noise nodes
+static void noiseControls(tact::Signal& sig, std::uint64_t& seed)
 {
     float gain = (float)sig.gain;
     float bias = (float)sig.bias;
     ImGui::DragFloat("Gain", &gain, 0.001f, -1, 1, "%0.3f");
     ImGui::DragFloat("Bias", &bias, 0.001f, -1, 1, "%0.3f");
+    ImGui::InputScalar("Seed", ImGuiDataType_U64, &seed);
     sig.gain = gain;
     sig.bias = bias;
 }
 
+void NoiseNode::update()
+{
+    noiseControls(sig, sig.getAs<tact::Noise>()->seed);
+}
+
+void PinkNoiseNode::update()
+{
+    noiseControls(sig, sig.getAs<tact::PinkNoise>()->seed);
+}
+
+void BrownNoiseNode::update()
+{
+    noiseControls(sig, sig.getAs<tact::BrownNoise>()->seed);
+}
+
+void BandNoiseNode::update()
+{
+    auto cast = sig.getAs<tact::BandNoise>();
+    float low  = (float)cast->low;
+    float high = (float)cast->high;
+    if (ImGui::DragFloat("Low", &low, 1, 1, 1000, "%.0f Hz"))
+        cast->low = low;
+    if (ImGui::DragFloat("High", &high, 1, 1, 1000, "%.0f Hz"))
+        cast->high = high;
+    noiseControls(sig, cast->seed);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void TimeNode::update() {}
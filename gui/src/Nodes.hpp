@@ -151,6 +151,7 @@ struct ExpressionNode : public SignalNode<tact::Expression> {
     void getString();
     void update();
     char buffer[256];
+    char varBuffer[32] = "";
     bool ok = true;
 };
 
@@ -225,6 +226,27 @@ struct NoiseNode : public SignalNode<tact::Noise> {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+struct PinkNoiseNode : public SignalNode<tact::PinkNoise> {
+    using SignalNode::SignalNode;
+    void update();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct BrownNoiseNode : public SignalNode<tact::BrownNoise> {
+    using SignalNode::SignalNode;
+    void update();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+struct BandNoiseNode : public SignalNode<tact::BandNoise> {
+    using SignalNode::SignalNode;
+    void update();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 struct TimeNode : public SignalNode<tact::Time> {
     using SignalNode::SignalNode;
     void update();
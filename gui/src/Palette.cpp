@@ -14,6 +14,9 @@ const std::string &paletteName(PItem id)
         {PItem::Scalar, "Scalar"},
         {PItem::Ramp, "Ramp"},
         {PItem::Noise, "Noise"},
+        {PItem::PinkNoise, "Pink Noise"},
+        {PItem::BrownNoise, "Brown Noise"},
+        {PItem::BandNoise, "Band Noise"},
         {PItem::Expression, "Expression"},
         {PItem::Sum, "Sum"},
         {PItem::Product, "Product"},
@@ -48,6 +51,9 @@ const std::string& paletteDescription(PItem id) {
         {PItem::Scalar, "Creates a constant sample value"},
         {PItem::Ramp, "Creates a sample that linearly increases or decreases with time"},
         {PItem::Noise, "Creates white noise"},
+        {PItem::PinkNoise, "Creates pink (1/f) noise"},
+        {PItem::BrownNoise, "Creates brown (1/f^2) noise"},
+        {PItem::BandNoise, "Creates white noise limited to a frequency band"},
         {PItem::Expression, "Creates a sample by evaluating a mathematical expression"},
         {PItem::Sum, "Sums two or more Signals"},
         {PItem::Product, "Multiplies two or more Signals"},
@@ -81,7 +87,7 @@ void Palette::update()
     ImGui::PushStyleColor(ImGuiCol_ChildBg, {0,0,0,0});
     ImGui::BeginChild("PalleteList", ImVec2(0, avail.y));
     static std::vector<std::pair<std::string, std::vector<PItem>>> signals = {
-        {"Oscillators", {PItem::Sine, PItem::Square, PItem::Saw, PItem::Triangle, PItem::Chirp, PItem::FM, PItem::Pwm, PItem::Noise}},
+        {"Oscillators", {PItem::Sine, PItem::Square, PItem::Saw, PItem::Triangle, PItem::Chirp, PItem::FM, PItem::Pwm, PItem::Noise, PItem::PinkNoise, PItem::BrownNoise, PItem::BandNoise}},
         {"Envelopes", {PItem::Envelope, PItem::KeyedEnvelope, PItem::ASR, PItem::ADSR, PItem::ExponentialDecay, PItem::PolyBezier, PItem::SignalEnvelope}},
         {"Processes", {PItem::Sum, PItem::Product, PItem::Repeater, PItem::Stretcher, PItem::Reverser, PItem::Sequencer}},
         {"General", {PItem::Expression, PItem::Ramp, PItem::Scalar}}};
@@ -28,7 +28,10 @@ enum class PItem {
     ExponentialDecay,
     KeyedEnvelope,
     SignalEnvelope,
-    PolyBezier
+    PolyBezier,
+    PinkNoise,
+    BrownNoise,
+    BandNoise
 };
 
 /// Returns the name of a Syntacts signal
@@ -85,10 +85,11 @@ void Player::updateChannels()
     ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, {ImGui::GetStyle().FramePadding.x, 0});
     ImGui::BeginChild("Channels", ImVec2(0, 0), false, ImGuiWindowFlags_NoBackground);
     if (gui.device.session) {
+        pollEvents();
         for (int i = 0; i < gui.device.session->getCurrentDevice().maxChannels; ++i)
         {
             ImGui::PushID(i);
-            bool playing = gui.device.session->isPlaying(i);
+            bool playing = i < m_playing.size() && m_playing[i];
             if (playing)
                 ImGui::PushStyleColor(ImGuiCol_Button, Grays::Gray50);
             auto label = std::to_string(i);
@@ -167,6 +168,20 @@ void Player::updateChannels()
     ImGui::PopStyleVar();
 }
 
+/// Tracks which channels are playing from the Session's voice events
+void Player::pollEvents()
+{
+    tact::Event event;
+    while (gui.device.session->pollEvent(event)) {
+        if (event.channel >= m_playing.size())
+            continue;
+        if (event.type == tact::Event::VoiceStarted)
+            m_playing[event.channel] = true;
+        else if (event.type == tact::Event::ChannelIdle)
+            m_playing[event.channel] = false;
+    }
+}
+
 void Player::playCh(int ch)
 {
     tact::Signal sig;
@@ -188,4 +203,5 @@ void Player::playSelected()
 void Player::rechannel()
 {
     int maxChannels = gui.device.session ? gui.device.session->getCurrentDevice().maxChannels : 0;
+    m_playing.assign(maxChannels, false);
 }
\ No newline at end of file
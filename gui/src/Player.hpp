@@ -11,12 +11,14 @@ public:
 private:
 
     void updateChannels();
+    void pollEvents();
     void playCh(int ch);
     void playSelected();
     void rechannel();
 
 private:
     int m_payload;
+    std::vector<bool> m_playing;
     float m_masterVol = 1.0f;
     float m_masterPitch = 0.0f;
 };
\ No newline at end of file
@@ -117,6 +117,41 @@ void Spatializer::update()
     else
         ImGui::DragFloat("Position", &m_target.pos.x, 0.005f, 0.0f, 1.0f);
     ImGui::DragFloat("Radius", &m_target.radius, 0.005f, 0.0f, 1.0f);
+
+    NodeSlot(m_pathXName.c_str(), ImVec2(control_width, 0));
+    if (SignalTarget()) {
+        m_pathXName = SignalPayload().first;
+        m_pathX = SignalPayload().second;
+        if (m_follow)
+            follow();
+    }
+    ImGui::SameLine();
+    ImGui::Text("X(t)");
+    NodeSlot(m_pathYName.c_str(), ImVec2(control_width, 0));
+    if (SignalTarget()) {
+        m_pathYName = SignalPayload().first;
+        m_pathY = SignalPayload().second;
+        if (m_follow)
+            follow();
+    }
+    ImGui::SameLine();
+    ImGui::Text("Y(t)");
+    ImGui::SameLine();
+    if (ImGui::ToggleButton(ICON_FA_ROUTE, &m_follow)) {
+        if (m_follow)
+            follow();
+        else
+            spatializer.clearTrajectory();
+    }
+    gui.status.showTooltip("Toggle Trajectory");
+    // show where the Session has moved the target
+    if (m_follow && gui.device.session) {
+        double t = gui.device.session->getTime() - m_followStart;
+        if (m_pathXName != "##EmptyX")
+            m_target.pos.x = (float)m_pathX.sample(t);
+        if (m_pathYName != "##EmptyY")
+            m_target.pos.y = (float)m_pathY.sample(t);
+    }
     static std::vector<ImVec2> points(100);
     ImGui::PlotSignal("##Empty", CurveSignal(g_curveMap[m_rollOffHoveredIdx == -1 ? m_rollOffIndex : m_rollOffHoveredIdx].second), points, 0, 2, Greens::Chartreuse, 1, ImVec2(control_width,45), false, false);     
     m_rollOffHoveredIdx = -1;
@@ -181,6 +216,7 @@ void Spatializer::update()
         ImGui::BulletText("Move the Target location by right-mouse dragging the grid");
         ImGui::BulletText("Change the Target radius with the mouse scroll wheel");
         ImGui::BulletText("Select a volume roll-off method from the drop down list");
+        ImGui::BulletText("Drag Signals from the Library into the X(t) and Y(t) slots and toggle " ICON_FA_ROUTE " to move the Target along them");
         ImGui::Separator();
         ImGui::BulletText("Drag Signals from the Library into the Signal slot");
         ImGui::BulletText("Left-click and right-click the " ICON_FA_PLAY " button to play and stop the Signal, respectively");
@@ -213,6 +249,14 @@ void Spatializer::onSessionDestroy() {
     spatializer.unbind();
 }
 
+void Spatializer::follow() {
+    // empty slots hold the current target position
+    auto x = m_pathXName != "##EmptyX" ? m_pathX : tact::Signal(tact::Scalar(m_target.pos.x));
+    auto y = m_pathYName != "##EmptyY" ? m_pathY : tact::Signal(tact::Scalar(m_target.pos.y));
+    spatializer.setTrajectory(x, y);
+    m_followStart = gui.device.session ? gui.device.session->getTime() : 0;
+}
+
 void Spatializer::sync() {
     auto existing = spatializer.getChannels();
     std::vector<int> remove;
@@ -39,9 +39,15 @@ private:
     void fillGrid();
     void onSessionChange();
     void onSessionDestroy();
+    void follow();
 
 private:
     tact::Signal m_signal;
+    tact::Signal m_pathX, m_pathY;
+    std::string m_pathXName = "##EmptyX";
+    std::string m_pathYName = "##EmptyY";
+    bool m_follow = false;
+    double m_followStart = 0;
     int m_rollOffIndex = 0;
     int m_rollOffHoveredIdx = -1;
     std::string m_sigName = "##Empty";
@@ -0,0 +1,90 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Tact/Error.hpp>
+#include <Tact/Signal.hpp>
+#include <memory>
+#include <string>
+
+namespace tact {
+
+/// Sends commands to a Server running in another process through named shared memory.
+class Client {
+public:
+
+    /// Constructor.
+    Client();
+
+    /// Destructor. Disconnects if connected.
+    ~Client();
+
+    /// Connects to a running Server by the name of its shared memory region.
+    int connect(const std::string& name = "syntacts");
+
+    /// Disconnects from the Server.
+    void disconnect();
+
+    /// Returns true if connected to a Server.
+    bool isConnected() const;
+
+    /// Plays a Signal on the specified channel of the Server's Session.
+    int play(int channel, const Signal& signal);
+
+    /// Plays a Signal from the Server's Syntacts Library by name (avoids sending the Signal).
+    int playLibrary(int channel, const std::string& name);
+
+    /// Stops playing Signals on the specified channel.
+    int stop(int channel);
+
+    /// Stops playing Signals on all channels.
+    int stopAll();
+
+    /// Pauses playing Signals on the specified channel.
+    int pause(int channel);
+
+    /// Resumes playing Signals on the specified channel.
+    int resume(int channel);
+
+    /// Sets the volume on the specified channel.
+    int setVolume(int channel, double volume);
+
+    /// Sets the pitch on the specified channel.
+    int setPitch(int channel, double pitch);
+
+    /// Gets the number of channels of the Server's Session.
+    int getChannelCount() const;
+
+    /// Gets the sample rate of the Server's Session.
+    double getSampleRate() const;
+
+private:
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace tact
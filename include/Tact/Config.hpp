@@ -32,6 +32,12 @@
 /// The maximum number of signals that can be played in unison (polyphony) on a single channel
 #define SYNTACTS_MAX_VOICES 8
 
+/// The maximum number of spatial panners (e.g. bound Spatializers) a Session evaluates in its audio thread
+#define SYNTACTS_MAX_PANNERS 16
+
+/// The maximum number of Signal sources each spatial panner mixes into its channels
+#define SYNTACTS_MAX_SOURCES 32
+
 /// If uncommented, Signals will use a fixed size memory pool for allocation.
 /// At this time, there doesn't seem to a great deal of benifit from doing this,
 /// but one day it may be be possible to reap the benifits of 
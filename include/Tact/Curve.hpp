@@ -26,6 +26,7 @@
 
 #include <Tact/Serialization.hpp>
 #include <memory>
+#include <type_traits>
 
 #define TACT_CURVE(T) struct T { \
                           double operator()(double t) const; \
@@ -45,24 +46,42 @@ namespace tact {
 
 /// Curve Type Erasure
 class Curve {
+public:
+    /// Number of intervals in a baked Curve's lookup table
+    static constexpr int TABLE_SIZE = 4096;
+    /// Maximum error of a baked Curve on [0,1]; intervals that cannot meet it (e.g. steps) are evaluated exactly
+    static constexpr double TABLE_TOLERANCE = 1e-6;
 public:
     /// Default constructor
     Curve();    
     /// Constructor
     template <typename T>
-    Curve(T curve) : m_ptr(std::make_shared<Model<T>>(std::move(curve))) { }
+    Curve(T curve) : m_ptr(makeModel(std::move(curve))) { }
     /// Transforms interpolant t in range [0,1] 
     double operator()(double t) const;
     /// Returns value in between a and b given interpolant t in range [0,1]
     double operator()(double a, double b, double t) const;
+    /// Transforms n interpolants t into y
+    void operator()(const double* t, double* y, int n) const;
     /// Returns curve name
     const char* name() const;    
+    /// Returns true if the underlying curve is of type T
+    template <typename T>
+    bool isType() const { return dynamic_cast<const Model<T>*>(m_ptr.get()) != nullptr; }
+    /// Returns a copy of this Curve evaluated by linear interpolation of a lookup table (shared by all Curves of a stateless type; not saved)
+    Curve baked() const;
+    /// Returns a copy of this Curve evaluated exactly
+    Curve exact() const;
+    /// Returns true if this Curve is evaluated from a lookup table
+    bool isBaked() const;
 public:
+    struct Table;
     struct Concept {
         Concept() = default;
         virtual ~Concept() = default;
         virtual double operator()(double t) const = 0;
         virtual const char* name() const = 0;
+        virtual std::shared_ptr<const Table> table() const = 0;
         template <class Archive>
         void serialize(Archive& archive) {}
     };
@@ -74,11 +93,34 @@ public:
         { return m_model(t); }
         const char* name() const override
         { return m_model.name(); }
+        std::shared_ptr<const Table> table() const override {
+            // stateless curves of the same type are identical, so they bake once
+            if constexpr (std::is_empty<T>::value) {
+                static const std::shared_ptr<const Table> shared = bake(*this);
+                return shared;
+            }
+            else
+                return bake(*this);
+        }
         T m_model;
         TACT_SERIALIZE(TACT_PARENT(Concept), TACT_MEMBER(m_model));
     };
+private:
+    /// Stateless curves share one immutable Model, so constructing them never allocates
+    template <typename T>
+    static std::shared_ptr<const Concept> makeModel(T curve) {
+        if constexpr (std::is_empty<T>::value) {
+            static const std::shared_ptr<const Concept> shared = std::make_shared<Model<T>>();
+            return shared;
+        }
+        else
+            return std::make_shared<Model<T>>(std::move(curve));
+    }
+    /// Tabulates curve over [0,1]
+    static std::shared_ptr<const Table> bake(const Concept& curve);
 private:
     std::shared_ptr<const Concept> m_ptr;
+    std::shared_ptr<const Table> m_table; ///< lookup table if baked, otherwise null
 private:
     TACT_SERIALIZE(TACT_MEMBER(m_ptr));
 };
@@ -6,20 +6,115 @@ double IOscillator::length() const {
     return INF;
 }
 
+inline double IOscillator::peak() const {
+    return 1;
+}
+
+inline double ChirpPhase::sample(double t) const {
+    return TWO_PI * t * (initial + 0.5 * rate * t);
+}
+
+inline void ChirpPhase::sample(const double* t, double* b, int n) const {
+    const double a = TWO_PI * initial, c = PI * rate;
+    for (int i = 0; i < n; ++i)
+        b[i] = t[i] * (a + c * t[i]);
+}
+
+inline double ChirpPhase::length() const {
+    return INF;
+}
+
+inline double FmPhase::sample(double t) const {
+    return TWO_PI * frequency * t + index * modulation.sample(t);
+}
+
+inline void FmPhase::sample(const double* t, double* b, int n) const {
+    modulation.sample(t, b, n);
+    const double w = TWO_PI * frequency;
+    for (int i = 0; i < n; ++i)
+        b[i] = w * t[i] + index * b[i];
+}
+
+inline double FmPhase::length() const {
+    return INF;
+}
+
 inline double Sine::sample(double t) const {
     return std::sin(x.sample(t));
 }
 
+inline void Sine::sample(const double* t, double* b, int n) const {
+    x.sample(t, b, n);
+    for (int i = 0; i < n; ++i)
+        b[i] = std::sin(b[i]);
+}
+
+namespace detail {
+/// Returns the fraction of a cycle in [0, 1) at phase x in radians.
+inline double cycle(double x) {
+    double u = x * (0.5 * INV_PI);
+    return u - std::floor(u);
+}
+} // namespace detail
+
+// the shapes below equal sign(sin(x)), -2/pi*atan(cot(x/2)) and 2/pi*asin(sin(x)),
+// computed from the position in the cycle instead of trigonometric functions
+
 inline double Square::sample(double t) const {
-    return std::sin(x.sample(t)) > 0 ? 1.0 : -1.0;
+    double u = detail::cycle(x.sample(t));
+    return u > 0 && u < 0.5 ? 1.0 : -1.0;
+}
+
+inline void Square::sample(const double* t, double* b, int n) const {
+    x.sample(t, b, n);
+    for (int i = 0; i < n; ++i) {
+        double u = detail::cycle(b[i]);
+        b[i] = u > 0 && u < 0.5 ? 1.0 : -1.0;
+    }
 }
 
 inline double Saw::sample(double t) const {
-    return -2 * INV_PI * std::atan(std::cos(0.5 * x.sample(t)) / std::sin(0.5 * x.sample(t)));
+    return 2 * detail::cycle(x.sample(t)) - 1;
+}
+
+inline void Saw::sample(const double* t, double* b, int n) const {
+    x.sample(t, b, n);
+    for (int i = 0; i < n; ++i)
+        b[i] = 2 * detail::cycle(b[i]) - 1;
 }
 
 inline double Triangle::sample(double t) const {
-    return 2 * INV_PI * std::asin(std::sin(x.sample(t)));
+    return 1 - 4 * std::abs(detail::cycle(x.sample(t) + HALF_PI) - 0.5);
+}
+
+inline void Triangle::sample(const double* t, double* b, int n) const {
+    x.sample(t, b, n);
+    for (int i = 0; i < n; ++i)
+        b[i] = 1 - 4 * std::abs(detail::cycle(b[i] + HALF_PI) - 0.5);
+}
+
+inline double Chirp::sample(double t) const {
+    return std::sin(TWO_PI * t * (initial + 0.5 * rate * t));
+}
+
+inline double Chirp::length() const {
+    return INF;
+}
+
+inline double Chirp::peak() const {
+    return 1;
+}
+
+inline double FmSine::sample(double t) const {
+    return std::sin(TWO_PI * frequency * t + index * std::sin(TWO_PI * modulation * t));
+}
+
+inline double FmSine::length() const {
+    return INF;
+}
+
+inline double FmSine::peak() const {
+    return 1;
 }
 
 
@@ -31,4 +126,8 @@ inline double Pwm::length() const {
     return INF;
 }
 
+inline double Pwm::peak() const {
+    return 1;
+}
+
 } // namespace tact
\ No newline at end of file
@@ -1,28 +1,40 @@
 namespace tact
 {
 
-inline Sequence& Sequence::operator<<(double rhs) {
+inline Sequence& Sequence::operator<<(double rhs) & {
     return push(rhs);
 }
 
-inline Sequence& Sequence::operator<<(Signal rhs) {
-    return push(rhs);
+inline Sequence& Sequence::operator<<(Signal rhs) & {
+    return push(std::move(rhs));
 }
 
-inline Sequence& Sequence::operator<<(Sequence rhs) {
-    return push(rhs);
+inline Sequence& Sequence::operator<<(Sequence rhs) & {
+    return push(std::move(rhs));
+}
+
+inline Sequence Sequence::operator<<(double rhs) && {
+    return std::move(push(rhs));
+}
+
+inline Sequence Sequence::operator<<(Signal rhs) && {
+    return std::move(push(std::move(rhs)));
+}
+
+inline Sequence Sequence::operator<<(Sequence rhs) && {
+    return std::move(push(std::move(rhs)));
 }
 
 inline Sequence operator<<(Signal lhs, Signal rhs) {
     Sequence seq;
-    seq.push(lhs);
-    seq.push(rhs);
+    seq.push(std::move(lhs));
+    seq.push(std::move(rhs));
     return seq;
 }
 
 inline Sequence operator<<(Signal lhs, double rhs) {
     Sequence seq;
-    seq.push(lhs);
+    seq.push(std::move(lhs));
     seq.head += rhs;
     return seq;
 }
@@ -30,7 +42,7 @@ inline Sequence operator<<(Signal lhs, double rhs) {
 inline Sequence operator<<(double lhs, Signal rhs) {
     Sequence seq;
     seq.head += lhs;
-    seq.push(rhs);
+    seq.push(std::move(rhs));
     return seq;
 }   
 
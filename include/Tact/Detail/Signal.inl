@@ -1,4 +1,7 @@
 #include <Tact/Signal.hpp>
+#include <type_traits>
+#include <utility>
+#include <cmath>
 
 namespace tact
 {
@@ -28,6 +31,7 @@ Signal::Signal(T signal) :
     static_assert((sizeof(Model<T>)) <= SYNTACTS_POOL_BLOCK_SIZE, "Signal allocation would exceed SIGNAL_BLOCK SIZE");
 #endif
 #endif
+    refresh();
 }
 
 inline double Signal::sample(double t) const
@@ -42,7 +46,32 @@ inline void Signal::sample(const double *t, double *b, int n) const
 
 inline double Signal::length() const
 {
+#ifdef SYNTACTS_USE_SHARED_PTR
     return m_ptr->length();
+#else
+    return std::isnan(m_length) ? m_ptr->length() : m_length;
+#endif
+}
+
+inline bool Signal::finite() const
+{
+    return length() < INF;
+}
+
+inline double Signal::peak() const
+{
+#ifdef SYNTACTS_USE_SHARED_PTR
+    double peak = m_ptr->peak();
+#else
+    double peak = std::isnan(m_peak) ? m_ptr->peak() : m_peak;
+#endif
+    // gain == 0 is checked so an unknown (infinite) peak doesn't scale to NaN
+    return (gain == 0 ? 0 : std::abs(gain) * peak) + std::abs(bias);
+}
+
+inline bool Signal::silent(double t0, double t1) const
+{
+    return bias == 0 && (gain == 0 || m_ptr->silent(t0, t1));
 }
 
 template <typename T>
@@ -55,6 +84,10 @@ template <typename T> inline T* Signal::getAs() const {
     return static_cast<T*>(m_ptr->get());
 }
 
+template <typename T> inline T* Signal::getAs() {
+    return static_cast<T*>(get());
+}
+
 #ifdef SYNTACTS_USE_POOL
 inline Signal::Pool& Signal::pool() {
     static Signal::Pool p;
@@ -83,11 +116,44 @@ double Signal::Model<T>::sample(double t) const
     return m_model.sample(t); 
 }
 
+namespace detail {
+/// Detects Signal types that provide their own block sample(const double*, double*, int)
+template <typename T, typename = void>
+struct HasBlockSample : std::false_type { };
+template <typename T>
+struct HasBlockSample<T, std::void_t<decltype(std::declval<const T&>().sample(std::declval<const double*>(), std::declval<double*>(), 0))>> : std::true_type { };
+
+/// Detects Signal types that can report times at which they are zero
+template <typename T, typename = void>
+struct HasSilent : std::false_type { };
+template <typename T>
+struct HasSilent<T, std::void_t<decltype(std::declval<const T&>().silent(0.0, 0.0))>> : std::true_type { };
+
+/// Detects Signal types that can bound the magnitude of their samples
+template <typename T, typename = void>
+struct HasPeak : std::false_type { };
+template <typename T>
+struct HasPeak<T, std::void_t<decltype(std::declval<const T&>().peak())>> : std::true_type { };
+
+/// Detects static (st) Signal types, which provide their equivalent runtime Signal
+template <typename T, typename = void>
+struct HasRuntime : std::false_type { };
+template <typename T>
+struct HasRuntime<T, std::void_t<decltype(std::declval<const T&>().runtime())>> : std::true_type { };
+} // namespace detail
+
 template <typename T>
 void Signal::Model<T>::sample(const double* t, double* b, int n, double s, double o) const 
 { 
-    for (int i = 0; i < n; ++i) 
-        b[i] = m_model.sample(t[i]) * s + o;
+    if constexpr (detail::HasBlockSample<T>::value) {
+        m_model.sample(t, b, n);
+        for (int i = 0; i < n; ++i)
+            b[i] = b[i] * s + o;
+    }
+    else {
+        for (int i = 0; i < n; ++i) 
+            b[i] = m_model.sample(t[i]) * s + o;
+    }
 }
 
 template <typename T>
@@ -96,6 +162,24 @@ double Signal::Model<T>::length() const
     return m_model.length(); 
 }
 
+template <typename T>
+double Signal::Model<T>::peak() const
+{
+    if constexpr (detail::HasPeak<T>::value)
+        return m_model.peak();
+    else
+        return INF;
+}
+
+template <typename T>
+bool Signal::Model<T>::silent(double t0, double t1) const
+{
+    if constexpr (detail::HasSilent<T>::value)
+        return m_model.silent(t0, t1);
+    else
+        return false;
+}
+
 template <typename T>
 std::type_index Signal::Model<T>::typeId() const
 { 
@@ -109,6 +193,17 @@ void* Signal::Model<T>::get() const
     return (void*)&m_model; 
 }
 
+template <typename T>
+bool Signal::Model<T>::runtime(Signal& out) const
+{
+    if constexpr (detail::HasRuntime<T>::value) {
+        out = m_model.runtime();
+        return true;
+    }
+    else
+        return false;
+}
+
 #ifndef SYNTACTS_USE_SHARED_PTR
 #ifndef SYNTACTS_USE_POOL
 
@@ -135,6 +230,14 @@ std::unique_ptr<Signal::Concept, Signal::Deleter> Signal::Model<T>::copy() const
 
 template <class Archive>
 void Signal::save(Archive& archive) const {
+    // static Signals have no registered type, so save their runtime equivalent
+    Signal equivalent;
+    if (m_ptr->runtime(equivalent)) {
+        equivalent.bias = equivalent.bias * gain + bias;
+        equivalent.gain *= gain;
+        equivalent.save(archive);
+        return;
+    }
     archive(TACT_MEMBER(gain), TACT_MEMBER(bias), TACT_MEMBER(m_ptr));
 }
 
@@ -147,6 +250,14 @@ void Signal::load(Archive& archive) {
 #else
     archive(TACT_MEMBER(gain), TACT_MEMBER(bias), TACT_MEMBER(m_ptr));
 #endif
+    // types kept to load old archives convert to their current type, so saving again writes the current layout
+    Signal current;
+    if (m_ptr->runtime(current)) {
+        bias = current.bias * gain + bias;
+        gain *= current.gain;
+        m_ptr = std::move(current.m_ptr);
+    }
+    refresh();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
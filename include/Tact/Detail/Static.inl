@@ -0,0 +1,261 @@
+#include <Tact/Static.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace tact {
+namespace st {
+
+template <typename E>
+inline const E& Expr<E>::self() const {
+    return static_cast<const E&>(*this);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline double Time::sample(double t) const {
+    return t;
+}
+
+inline double Time::length() const {
+    return INF;
+}
+
+inline Signal Time::runtime() const {
+    return tact::Time();
+}
+
+inline Scalar::Scalar(double _value) :
+    value(_value)
+{ }
+
+inline double Scalar::sample(double) const {
+    return value;
+}
+
+inline double Scalar::length() const {
+    return INF;
+}
+
+inline Signal Scalar::runtime() const {
+    return tact::Scalar(value);
+}
+
+inline Ramp::Ramp(double _initial, double _rate) :
+    initial(_initial), rate(_rate), duration(INF)
+{ }
+
+inline Ramp::Ramp(double _initial, double _final, double _duration) :
+    initial(_initial), rate((_final - _initial) / _duration), duration(_duration)
+{ }
+
+inline double Ramp::sample(double t) const {
+    return initial + rate * t;
+}
+
+inline double Ramp::length() const {
+    return duration;
+}
+
+inline Signal Ramp::runtime() const {
+    tact::Ramp ramp(initial, rate);
+    ramp.duration = duration;
+    return ramp;
+}
+
+inline Runtime::Runtime(Signal _signal) :
+    signal(std::move(_signal))
+{ }
+
+inline double Runtime::sample(double t) const {
+    return signal.sample(t);
+}
+
+inline double Runtime::length() const {
+    return signal.length();
+}
+
+inline Signal Runtime::runtime() const {
+    return signal;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename E>
+inline Affine<E>::Affine(E _e, double _gain, double _bias) :
+    e(std::move(_e)), gain(_gain), bias(_bias)
+{ }
+
+template <typename E>
+inline double Affine<E>::sample(double t) const {
+    return e.sample(t) * gain + bias;
+}
+
+template <typename E>
+inline double Affine<E>::length() const {
+    return e.length();
+}
+
+template <typename E>
+inline Signal Affine<E>::runtime() const {
+    return e.runtime() * gain + bias;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline double shape::Sine::apply(double phase) {
+    return std::sin(phase);
+}
+
+inline Signal shape::Sine::runtime(Signal x) {
+    return tact::Sine(std::move(x));
+}
+
+inline double shape::Square::apply(double phase) {
+    return std::sin(phase) > 0 ? 1.0 : -1.0;
+}
+
+inline Signal shape::Square::runtime(Signal x) {
+    return tact::Square(std::move(x));
+}
+
+inline double shape::Saw::apply(double phase) {
+    return -2 * INV_PI * std::atan(std::cos(0.5 * phase) / std::sin(0.5 * phase));
+}
+
+inline Signal shape::Saw::runtime(Signal x) {
+    return tact::Saw(std::move(x));
+}
+
+inline double shape::Triangle::apply(double phase) {
+    return 2 * INV_PI * std::asin(std::sin(phase));
+}
+
+inline Signal shape::Triangle::runtime(Signal x) {
+    return tact::Triangle(std::move(x));
+}
+
+template <typename Shape, typename X>
+inline Oscillator<Shape, X>::Oscillator(double hertz, X _x) :
+    x(std::move(_x)), omega(TWO_PI * hertz)
+{ }
+
+template <typename Shape, typename X>
+inline Oscillator<Shape, X>::Oscillator(X _x) :
+    x(std::move(_x)), omega(1)
+{ }
+
+template <typename Shape, typename X>
+inline double Oscillator<Shape, X>::sample(double t) const {
+    return Shape::apply(omega * x.sample(t));
+}
+
+template <typename Shape, typename X>
+inline double Oscillator<Shape, X>::length() const {
+    return INF;
+}
+
+template <typename Shape, typename X>
+inline Signal Oscillator<Shape, X>::runtime() const {
+    return Shape::runtime(omega * x.runtime());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+inline double op::Add::apply(double a, double b)      { return a + b; }
+inline double op::Add::length(double a, double b)     { return std::max(a, b); }
+inline Signal op::Add::runtime(Signal a, Signal b)    { return std::move(a) + std::move(b); }
+
+inline double op::Subtract::apply(double a, double b)   { return a - b; }
+inline double op::Subtract::length(double a, double b)  { return std::max(a, b); }
+inline Signal op::Subtract::runtime(Signal a, Signal b) { return std::move(a) - std::move(b); }
+
+inline double op::Multiply::apply(double a, double b)   { return a * b; }
+inline double op::Multiply::length(double a, double b)  { return std::min(a, b); }
+inline Signal op::Multiply::runtime(Signal a, Signal b) { return std::move(a) * std::move(b); }
+
+template <typename Op, typename L, typename R>
+inline Operator<Op, L, R>::Operator(L _lhs, R _rhs) :
+    lhs(std::move(_lhs)), rhs(std::move(_rhs))
+{ }
+
+template <typename Op, typename L, typename R>
+inline double Operator<Op, L, R>::sample(double t) const {
+    return Op::apply(lhs.sample(t), rhs.sample(t));
+}
+
+template <typename Op, typename L, typename R>
+inline double Operator<Op, L, R>::length() const {
+    return Op::length(lhs.length(), rhs.length());
+}
+
+template <typename Op, typename L, typename R>
+inline Signal Operator<Op, L, R>::runtime() const {
+    return Op::runtime(lhs.runtime(), rhs.runtime());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+/// Scales and offsets a static Signal, folding into an existing Affine
+template <typename E>
+inline Affine<E> affine(const E& e, double gain, double bias) {
+    return Affine<E>(e, gain, bias);
+}
+template <typename E>
+inline Affine<E> affine(const Affine<E>& a, double gain, double bias) {
+    return Affine<E>(a.e, a.gain * gain, a.bias * gain + bias);
+}
+} // namespace detail
+
+template <typename L, typename R> 
+inline Sum<L, R> operator+(const Expr<L>& lhs, const Expr<R>& rhs) {
+    return Sum<L, R>(lhs.self(), rhs.self());
+}
+
+template <typename E> 
+inline auto operator+(const Expr<E>& lhs, double rhs) {
+    return detail::affine(lhs.self(), 1, rhs);
+}
+
+template <typename E> 
+inline auto operator+(double lhs, const Expr<E>& rhs) {
+    return detail::affine(rhs.self(), 1, lhs);
+}
+
+template <typename L, typename R> 
+inline Difference<L, R> operator-(const Expr<L>& lhs, const Expr<R>& rhs) {
+    return Difference<L, R>(lhs.self(), rhs.self());
+}
+
+template <typename E> 
+inline auto operator-(const Expr<E>& lhs, double rhs) {
+    return detail::affine(lhs.self(), 1, -rhs);
+}
+
+template <typename E> 
+inline auto operator-(double lhs, const Expr<E>& rhs) {
+    return detail::affine(rhs.self(), -1, lhs);
+}
+
+template <typename E> 
+inline auto operator-(const Expr<E>& lhs) {
+    return detail::affine(lhs.self(), -1, 0);
+}
+
+template <typename L, typename R> 
+inline Product<L, R> operator*(const Expr<L>& lhs, const Expr<R>& rhs) {
+    return Product<L, R>(lhs.self(), rhs.self());
+}
+
+template <typename E> 
+inline auto operator*(const Expr<E>& lhs, double rhs) {
+    return detail::affine(lhs.self(), rhs, 0);
+}
+
+template <typename E> 
+inline auto operator*(double lhs, const Expr<E>& rhs) {
+    return detail::affine(rhs.self(), lhs, 0);
+}
+
+} // namespace st
+} // namespace tact
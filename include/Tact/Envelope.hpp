@@ -27,8 +27,11 @@
 #include <Tact/Curve.hpp>
 #include <Tact/Oscillator.hpp>
 #include <Tact/Signal.hpp>
+#include <array>
+#include <atomic>
 #include <map>
 #include <utility>
+#include <vector>
 
 namespace tact
 {
@@ -42,6 +45,8 @@ public:
     Envelope(double duration = 0.1, double amplitude = 1.0);
     double sample(double t) const;
     double length() const;
+    double peak() const;
+    bool silent(double t0, double t1) const;
 
 public:
     double duration;
@@ -57,16 +62,81 @@ private:
 class SYNTACTS_API KeyedEnvelope
 {
 public:
+
+    /// A Key in the KeyedEnvelope.
+    struct Key {
+        double t;          ///< key time
+        double amplitude;  ///< key amplitude
+        Curve curve;       ///< curve used to interpolate from the previous key
+    };
+
     /// Constucts Envelope with initial amplitude
     KeyedEnvelope(double amplitude0 = 0.0);
+    /// Copy constructor.
+    KeyedEnvelope(const KeyedEnvelope& other);
+    /// Move constructor.
+    KeyedEnvelope(KeyedEnvelope&& other) noexcept;
+    /// Copy assignment.
+    KeyedEnvelope& operator=(const KeyedEnvelope& other);
+    /// Move assignment.
+    KeyedEnvelope& operator=(KeyedEnvelope&& other) noexcept;
     /// Adds a new amplitude at time t seconds. Uses curve to interpolate from previous amplitude.
     void addKey(double t, double amplitude, Curve curve = Curves::Linear());
+    /// Removes all keys, including the initial key.
+    void clearKeys();
+    /// Returns the number of keys in the envelope.
+    int keyCount() const;
+    /// Returns a key in the envelope (keys are ordered by their time).
+    const Key& getKey(int idx) const;
+    /// Returns a copy of the keys as a map of time -> (amplitude, curve), as the former public keys member held them (use addKey to modify).
+    std::map<double, std::pair<double, Curve>> keys() const;
+
     double sample(double t) const;
+    /// Samples n times t into buffer b (t should be ascending for best performance).
+    void sample(const double* t, double* b, int n) const;
     double length() const;
-public:
-    std::map<double, std::pair<double, Curve>> keys; ///< keys
+    /// Returns the largest key amplitude, widened by the key deltas of segments with non-linear curves (which may overshoot).
+    double peak() const;
+    /// Returns true if [t0, t1] is after the last key or only spans keys with zero amplitude.
+    bool silent(double t0, double t1) const;
+
+private:
+    /// Key plus the precomputed segment from the previous key.
+    struct Node {
+        Key key;
+        double invDuration = 0; ///< 1 / (key.t - previous key.t)
+        double delta       = 0; ///< key.amplitude - previous key.amplitude
+        bool   linear      = false; ///< segment is linear and skips the Curve call
+    };
+    /// Number of keys stored inline before spilling to the heap (enough for ADSR).
+    static constexpr int INLINE_KEYS = 5;
+    Node* nodes() { return m_count > INLINE_KEYS ? m_heap.data() : m_inline.data(); }
+    const Node* nodes() const { return m_count > INLINE_KEYS ? m_heap.data() : m_inline.data(); }
+    /// Recomputes the segments ending at keys idx and idx + 1.
+    void rebuildSegments(int idx);
+    /// Samples the envelope at t, advancing cursor to the key ending the active segment.
+    double sampleAt(double t, int& cursor) const;
+private:
+    std::array<Node, INLINE_KEYS> m_inline; ///< inline key storage
+    std::vector<Node> m_heap;     ///< key storage when more than INLINE_KEYS are added
+    int m_count;                  ///< number of keys
+    double m_length;              ///< time of the last key
+    mutable std::atomic<int> m_cursor; ///< key index hint of the last sample
 private:
-    TACT_SERIALIZE(TACT_MEMBER(keys));
+    friend class cereal::access;
+    template <class Archive>
+    void save(Archive& archive) const {
+        // archived as a map of time -> (amplitude, curve) for compatibility
+        archive(cereal::make_nvp("keys", keys()));
+    }
+    template <class Archive>
+    void load(Archive& archive) {
+        std::map<double, std::pair<double, Curve>> keys;
+        archive(TACT_MEMBER(keys));
+        clearKeys();
+        for (auto& k : keys)
+            addKey(k.first, k.second.first, std::move(k.second.second));
+    }
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -111,6 +181,7 @@ public:
     ExponentialDecay(double amplitude = 1, double decay = 6.907755);
     double sample(double t) const;
     double length() const;
+    double peak() const;
 public:
     double amplitude;
     double decay;
@@ -129,6 +200,7 @@ public:
                    double amplitude = 1.0);
     double sample(double t) const;
     double length() const;
+    double peak() const;
 
 public:
     Signal signal;
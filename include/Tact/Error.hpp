@@ -35,5 +35,13 @@ enum SyntactsError : int {
   SyntactsError_InvalidSampleRate = -6,
   SyntactsError_NoWaveform = -7,
   SyntactsError_ControlPanelFail = -8,
-  SyntactsError_InvalidAPI = -9
+  SyntactsError_InvalidAPI = -9,
+  SyntactsError_NotSupported = -10,
+  SyntactsError_NotConnected = -11,
+  SyntactsError_QueueFull = -12,
+  SyntactsError_SignalTooLarge = -13,
+  SyntactsError_AlreadyRecording = -14,
+  SyntactsError_FileError = -15,
+  SyntactsError_InvalidPanner = -16,
+  SyntactsError_InvalidSource = -17
 };
\ No newline at end of file
@@ -30,7 +30,10 @@
 #include <string>
 #include <random>
 #include <map>
-#include <random>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
 
 namespace tact
 {
@@ -54,6 +57,8 @@ public:
     Scalar(double value = 1);
     double sample(double t) const;
     double length() const;
+    double peak() const;
+    bool silent(double t0, double t1) const;
 public:
     double value;
 private:
@@ -70,6 +75,7 @@ public:
     Ramp(double initial, double final, double duration);
     double sample(double t) const;
     double length() const;
+    double peak() const;
 public:
     double initial;
     double rate;
@@ -80,53 +86,188 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
-/// A signal that generates white noise.
+/// Rate at which noise generators draw random values, independent of the playback rate (Hz).
+constexpr double NOISE_RATE = 96000;
+
+/// A signal that generates white noise. Values are a counter-based hash of (seed, time),
+/// so a given seed always renders the same noise and any number of copies may be sampled in parallel.
 class SYNTACTS_API Noise
 {
 public:
+    /// Constructs Noise with a seed unique to this process (saved with the Signal).
     Noise();
+    /// Constructs Noise with a specific seed.
+    Noise(std::uint64_t seed);
     double sample(double t) const;
+    void sample(const double* t, double* b, int n) const;
     double length() const;
+    /// Returns 1 (noise is clipped to [-1,1]).
+    double peak() const;
+public:
+    std::uint64_t seed; ///< random seed
 private:
-    TACT_SERIALIZABLE
+    friend class cereal::access;
+    // archives from before the seed (and class versions) load through LegacyNoise in Library.cpp
+    template <class Archive>
+    void save(Archive& archive, std::uint32_t) const {
+        archive(TACT_MEMBER(seed));
+    }
+    template <class Archive>
+    void load(Archive& archive, std::uint32_t) {
+        archive(TACT_MEMBER(seed));
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A signal that generates pink (1/f) noise by summing octaves of held white noise (Voss-McCartney).
+/// Like Noise, it is a pure function of (seed, time), so copies may be sampled in parallel.
+class SYNTACTS_API PinkNoise
+{
+public:
+    PinkNoise();
+    PinkNoise(std::uint64_t seed);
+    double sample(double t) const;
+    void sample(const double* t, double* b, int n) const;
+    double length() const;
+    /// Returns 1 (noise is clipped to [-1,1]).
+    double peak() const;
+public:
+    std::uint64_t seed; ///< random seed
+private:
+    static constexpr int OCTAVES = 14; ///< NOISE_RATE down to ~12 Hz
+    /// Held value of each octave at a noise counter, carried between the samples of one block.
+    struct Rows {
+        std::int64_t counter = INT64_MIN;
+        double value[OCTAVES] = {};
+    };
+    /// Returns the value at noise counter n, redrawing only the octaves of rows that changed.
+    double value(std::int64_t n, Rows& rows) const;
+private:
+    TACT_SERIALIZE(TACT_MEMBER(seed));
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A signal that generates brown (1/f^2) noise by summing octaves of interpolated white noise.
+/// Like Noise, it is a pure function of (seed, time), so copies may be sampled in parallel.
+class SYNTACTS_API BrownNoise
+{
+public:
+    BrownNoise();
+    BrownNoise(std::uint64_t seed);
+    double sample(double t) const;
+    void sample(const double* t, double* b, int n) const;
+    double length() const;
+    /// Returns 1 (noise is clipped to [-1,1]).
+    double peak() const;
+public:
+    std::uint64_t seed; ///< random seed
+private:
+    static constexpr int FIRST = 4, LAST = 14; ///< octaves of NOISE_RATE summed (~6 kHz down to ~6 Hz)
+    static constexpr int OCTAVES = LAST - FIRST + 1;
+    /// Segment of each octave around a noise position, carried between the samples of one block.
+    struct Rows {
+        bool valid = false;                 ///< segments have been drawn
+        std::int64_t last = 0;              ///< noise counter of the last sample
+        std::int64_t counter[OCTAVES] = {}; ///< left endpoint of each octave's segment
+        double a[OCTAVES] = {}, b[OCTAVES] = {}; ///< segment endpoint values
+    };
+    /// Returns the value at noise position x, redrawing only the octave segments of rows that changed.
+    double value(double x, Rows& rows) const;
+private:
+    TACT_SERIALIZE(TACT_MEMBER(seed));
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A signal that generates white noise band-limited to [low, high] Hz by 2nd order Butterworth filters.
+/// Filtering is stateful, so unlike Noise a copy must not be sampled from several threads at once.
+/// Playback from t = 0 forward is exactly repeatable, while seeking restarts the filters a short
+/// warm-up (until they settle, at most 0.1 s) before the new time.
+class SYNTACTS_API BandNoise
+{
+public:
+    BandNoise();
+    BandNoise(double low, double high, std::uint64_t seed);
+    BandNoise(double low, double high);
+    double sample(double t) const;
+    void sample(const double* t, double* b, int n) const;
+    double length() const;
+    /// Returns 1 (noise is clipped to [-1,1]).
+    double peak() const;
+public:
+    double low;         ///< lower band edge in Hz
+    double high;        ///< upper band edge in Hz
+    std::uint64_t seed; ///< random seed
+private:
+    /// Runs the filters up to counter n and returns the output there.
+    double advance(std::int64_t n) const;
+    struct Biquad { 
+        double b0 = 1, b1 = 0, b2 = 0, a1 = 0, a2 = 0; 
+        double x1 = 0, x2 = 0, y1 = 0, y2 = 0; 
+    };
+    mutable Biquad m_highpass, m_lowpass;
+    mutable double m_low = -1, m_high = -1; ///< band the filters were designed for
+    mutable double m_gain = 1;              ///< output normalization
+    mutable std::int64_t m_counter = -1;    ///< last counter filtered
+    mutable double m_last = 0;              ///< output at m_counter
+private:
+    TACT_SERIALIZE(TACT_MEMBER(low), TACT_MEMBER(high), TACT_MEMBER(seed));
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
 /// A signal that returns the evaluation of an expression f(t).
+/// Evaluation is re-entrant; the same Expression may be sampled from several channels or threads
+/// (up to four at once without waiting), and never compiles or locks while sampling.
 class SYNTACTS_API Expression {
 public:
     Expression(const std::string& expr = "sin(2*pi*100*t)");
     Expression(const Expression& other);
     ~Expression();
     double sample(double t) const;
+    /// Evaluates the expression at n times t into b
+    void sample(const double* t, double* b, int n) const;
     double length() const;
     bool setExpression(const std::string& expr);
     const std::string& getExpression() const;
     bool operator=(const std::string& expr);
+    /// Sets a named variable usable in the expression, adding it if new (false if the name is invalid or the expression fails to compile)
+    bool setVariable(const std::string& name, double value);
+    /// Gets the value of a named variable, or 0 if it does not exist
+    double getVariable(const std::string& name) const;
+    /// Gets all named variables and their values
+    const std::map<std::string, double>& getVariables() const;
+private:
+    /// Replaces the variables and expression together, compiling once
+    bool set(const std::string& expr, const std::map<std::string, double>& vars);
 private:
     class Impl;
     std::unique_ptr<Impl> m_impl;
 private:
     friend class cereal::access;
+    // archives from before variables (and class versions) load through LegacyExpression in Library.cpp
     template<class Archive>
-    void save(Archive& archive) const 
+    void save(Archive& archive, std::uint32_t) const 
     { 
         std::string expr = getExpression();
-        archive(TACT_MEMBER(expr)); 
+        std::map<std::string, double> vars = getVariables();
+        archive(TACT_MEMBER(expr), TACT_MEMBER(vars)); 
     }
     template<class Archive>
-    void load(Archive& archive) 
+    void load(Archive& archive, std::uint32_t) 
     { 
         std::string expr;
-        archive(TACT_MEMBER(expr)); 
-        setExpression(expr); 
+        std::map<std::string, double> vars;
+        archive(TACT_MEMBER(expr), TACT_MEMBER(vars)); 
+        set(expr, vars); 
     }
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
-/// A signal that generates white noise
+/// A signal defined by a chain of cubic Bezier curves, flattened into line segments by solve()
 class SYNTACTS_API PolyBezier
 {
 public:
@@ -141,12 +282,25 @@ public:
         TACT_SERIALIZE(TACT_MEMBER(cpL), TACT_MEMBER(p), TACT_MEMBER(cpR));
     };
 public:
+    PolyBezier() = default;
+    PolyBezier(const PolyBezier& other);
+    PolyBezier(PolyBezier&& other) noexcept;
+    PolyBezier& operator=(const PolyBezier& other);
+    PolyBezier& operator=(PolyBezier&& other) noexcept;
     double sample(double t) const;
+    /// Samples n times t into b, walking the solution from the last sampled segment
+    void sample(const double* t, double* b, int n) const;
     double length() const;
-    void solve();
+    /// Flattens points into solution, subdividing each curve until it is within tolerance of its line segments
+    void solve(double tolerance = 1e-4);
 public:
     std::vector<PointGroup> points;
     std::vector<Point> solution;
+private:
+    /// Samples t, starting the segment search from cursor and updating it
+    double sampleAt(double t, int& cursor) const;
+    std::vector<double> m_slopes;           ///< slope of the segment ending at each solution point
+    mutable std::atomic<int> m_cursor{0};   ///< solution index hint of the last sample
 private:
     friend class cereal::access;
     template<class Archive>
@@ -167,21 +321,103 @@ private:
 /// A Signal defined by an array of recorded samples (used internally for Library::importSignal).
 class SYNTACTS_API Samples {
 public:
+    /// Methods used to evaluate the Signal between recorded samples.
+    enum class Interpolation {
+        Nearest = 0, ///< previous sample (no interpolation)
+        Linear  = 1, ///< linear interpolation between neighboring samples
+        Cubic   = 2, ///< 4-point Catmull-Rom spline
+        Sinc    = 3  ///< 16-tap Blackman windowed sinc
+    };
+
     Samples();
     Samples(const std::vector<float>& samples, double sampleRate);
+    Samples(std::vector<float>&& samples, double sampleRate);
+    /// Constructs Samples over external memory kept alive by owner (e.g. a memory-mapped file).
+    Samples(std::shared_ptr<const void> owner, const float* data, std::size_t count, double sampleRate);
     double sample(double t) const;
+    /// Samples n times t into buffer b, choosing the interpolation kernel once per block.
+    void sample(const double* t, double* b, int n) const;
     double length() const;
     int sampleCount() const;
     double sampleRate() const;
     double getSample(int i) const;
+    /// Sets the interpolation method (runtime only, defaults to Nearest as before and is not serialized).
+    void setInterpolation(Interpolation interpolation);
+    /// Gets the interpolation method.
+    Interpolation getInterpolation() const;
+    /// Returns a copy resampled to sampleRate with a band-limited windowed sinc (use once at import, not during playback).
+    Samples resample(double sampleRate) const;
 private:
+    /// Saves external samples in place, laid out as the std::shared_ptr<const std::vector<float>> they are loaded into.
+    struct SharedSamples {
+        std::shared_ptr<const float> data; ///< first sample, sharing ownership with m_owner
+        std::size_t count;
+        template <class Archive>
+        void save(Archive& archive) const {
+            archive(cereal::make_nvp("ptr_wrapper", Pointer{*this}));
+        }
+        struct Pointer {
+            const SharedSamples& samples;
+            template <class Archive>
+            void save(Archive& archive) const {
+                std::uint32_t id = registerPointer(archive, samples.data, 0);
+                archive(cereal::make_nvp("id", id));
+                if (id & cereal::detail::msb_32bit)
+                    archive(cereal::make_nvp("data", Vector{samples}));
+            }
+        };
+        struct Vector {
+            const SharedSamples& samples;
+            template <class Archive>
+            void save(Archive& archive) const {
+                archive(cereal::make_size_tag(static_cast<cereal::size_type>(samples.count)));
+                if constexpr (cereal::traits::is_output_serializable<cereal::BinaryData<float>, Archive>::value)
+                    archive(cereal::binary_data(samples.data.get(), samples.count * sizeof(float)));
+                else
+                    for (std::size_t i = 0; i < samples.count; ++i)
+                        archive(samples.data.get()[i]);
+            }
+        };
+        // cereal 1.3.1 registers shared pointers by owner, earlier versions by address
+        template <class Archive>
+        static auto registerPointer(Archive& archive, const std::shared_ptr<const float>& data, int) -> decltype(archive.registerSharedPointer(data)) {
+            return archive.registerSharedPointer(data);
+        }
+        template <class Archive>
+        static std::uint32_t registerPointer(Archive& archive, const std::shared_ptr<const float>& data, long) {
+            return archive.registerSharedPointer(data.get());
+        }
+    };
+
     double m_sampleRate;
-    std::shared_ptr<const std::vector<float>> m_samples;
+    std::shared_ptr<const std::vector<float>> m_samples; ///< owned storage (null if external)
+    std::shared_ptr<const void> m_owner;  ///< keeps external storage alive
+    const float* m_data;                  ///< first sample
+    std::size_t m_count;                  ///< number of samples
+    Interpolation m_interpolation;
 private:
-    TACT_SERIALIZE(TACT_MEMBER(m_sampleRate), TACT_MEMBER(m_samples));
+    friend class cereal::access;
+    template <class Archive>
+    void save(Archive& archive) const {
+        archive(TACT_MEMBER(m_sampleRate));
+        if (m_samples || !m_data)
+            archive(TACT_MEMBER(m_samples));
+        else // external samples are written without copying them
+            archive(cereal::make_nvp("m_samples", SharedSamples{std::shared_ptr<const float>(m_owner, m_data), m_count}));
+    }
+    template <class Archive>
+    void load(Archive& archive) {
+        archive(TACT_MEMBER(m_sampleRate), TACT_MEMBER(m_samples));
+        m_owner = nullptr;
+        m_data  = m_samples ? m_samples->data() : nullptr;
+        m_count = m_samples ? m_samples->size() : 0;
+    }
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
 
-} // namespace tact
\ No newline at end of file
+} // namespace tact
+
+CEREAL_CLASS_VERSION(tact::Noise, 1);
+CEREAL_CLASS_VERSION(tact::Expression, 1);
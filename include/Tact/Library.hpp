@@ -26,6 +26,7 @@
 
 #include <Tact/Signal.hpp>
 #include <string>
+#include <cstddef>
 
 namespace tact {
 
@@ -37,7 +38,8 @@ enum class FileFormat {
     WAV = 2,       ///< WAV audio file format
     AIFF = 3,      ///< AIFF audio file format
     CSV = 4,       ///< comman-separated-value format,
-    JSON = 5       ///< human readable serialized format
+    JSON = 5,      ///< human readable serialized format
+    RAW = 6        ///< headerless 32-bit float PCM (memory-mapped on import)
 };
 
 namespace Library {
@@ -54,11 +56,18 @@ bool loadSignal(Signal& signal, const std::string& name);
 /// Erases a Signal from the global Syntacts Signal library if it exists.
 bool deleteSignal(const std::string& name);
 
+/// Serializes a Signal into a binary buffer (same encoding as SIG files).
+bool encodeSignal(const Signal& signal, std::string& buffer);
+
+/// Deserializes a Signal from a binary buffer created by encodeSignal.
+bool decodeSignal(Signal& signal, const char* data, std::size_t size);
+
 /// Saves a Signal as a specified file format.
 bool exportSignal(const Signal& signal, const std::string& filePath, FileFormat format = FileFormat::Auto, int sampleRate = 48000, double maxLength = 60); 
 
-/// Imports a Signal of a specific file format.
-bool importSignal(Signal& signal, const std::string& filePath, FileFormat format = FileFormat::Auto, int sampleRate = 48000);
+/// Imports a Signal of a specific file format. WAV/AIFF samples keep the file's rate unless resampled once to sampleRate,
+/// while RAW files are memory-mapped and sampleRate is the rate they were exported at (48000 if 0, as exportSignal's default).
+bool importSignal(Signal& signal, const std::string& filePath, FileFormat format = FileFormat::Auto, int sampleRate = 0);
 
 } // namespace Library
 
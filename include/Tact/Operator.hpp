@@ -46,7 +46,10 @@ private:
 struct Sum : public IOperator {
     using IOperator::IOperator;
     double sample(double t) const;
+    void sample(const double* t, double* b, int n) const;
     double length() const;
+    double peak() const;
+    bool silent(double t0, double t1) const;
 private:
     TACT_SERIALIZE(TACT_PARENT(IOperator));
 };
@@ -57,7 +60,10 @@ private:
 struct Product : public IOperator {
     using IOperator::IOperator;
     double sample(double t) const;
+    void sample(const double* t, double* b, int n) const;
     double length() const;
+    double peak() const;
+    bool silent(double t0, double t1) const;
 private:
     TACT_SERIALIZE(TACT_PARENT(IOperator));
 };
@@ -25,6 +25,8 @@
 #pragma once
 
 #include <Tact/Signal.hpp>
+#include <memory>
+#include <vector>
 
 namespace tact
 {
@@ -47,6 +49,8 @@ public:
     IOscillator(double hertz, Signal modulation, double index = 2.0);
     /// Returns infinity
     inline double length() const;
+    /// Returns 1
+    inline double peak() const;
 public:
     Signal x; ///< the Oscillator's input.    
 private:
@@ -55,12 +59,50 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/// The phase 2*pi*(initial*t + rate*t^2/2) of a linear chirp, used as an Oscillator input.
+class SYNTACTS_API ChirpPhase
+{
+public:
+    /// Constructor
+    ChirpPhase(double initial = 100, double rate = 100);
+    inline double sample(double t) const;
+    inline void sample(const double* t, double* b, int n) const;
+    inline double length() const;
+public:
+    double initial; ///< initial frequency in hertz
+    double rate;    ///< frequency ramp rate in hertz per second
+private:
+    TACT_SERIALIZE(TACT_MEMBER(initial), TACT_MEMBER(rate));
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// The phase 2*pi*frequency*t + index*modulation(t) of an FM Oscillator, used as an Oscillator input.
+class SYNTACTS_API FmPhase
+{
+public:
+    /// Constructor
+    FmPhase(double frequency = 100, Signal modulation = Signal(), double index = 2.0);
+    inline double sample(double t) const;
+    inline void sample(const double* t, double* b, int n) const;
+    inline double length() const;
+public:
+    double frequency;  ///< carrier frequency in hertz
+    Signal modulation; ///< modulating signal
+    double index;      ///< modulation index
+private:
+    TACT_SERIALIZE(TACT_MEMBER(frequency), TACT_MEMBER(modulation), TACT_MEMBER(index));
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 /// A sine wave Oscillator.
 class SYNTACTS_API Sine : public IOscillator
 {
 public:
     using IOscillator::IOscillator;
     inline double sample(double t) const;
+    inline void sample(const double* t, double* b, int n) const;
 private:
     TACT_SERIALIZE(TACT_PARENT(IOscillator));
 };
@@ -73,6 +115,7 @@ class SYNTACTS_API Square : public IOscillator
 public:
     using IOscillator::IOscillator;
     inline double sample(double t) const;
+    inline void sample(const double* t, double* b, int n) const;
 private:
     TACT_SERIALIZE(TACT_PARENT(IOscillator));
 };
@@ -85,6 +128,7 @@ class SYNTACTS_API Saw : public IOscillator
 public:
     using IOscillator::IOscillator;
     inline double sample(double t) const;
+    inline void sample(const double* t, double* b, int n) const;
 private:
     TACT_SERIALIZE(TACT_PARENT(IOscillator));
 };
@@ -97,12 +141,52 @@ class SYNTACTS_API Triangle : public IOscillator
 public:
     using IOscillator::IOscillator;
     inline double sample(double t) const;
+    inline void sample(const double* t, double* b, int n) const;
 private:
     TACT_SERIALIZE(TACT_PARENT(IOscillator));
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/// A sine wave whose frequency changes linearly, computed in closed form.
+class SYNTACTS_API Chirp
+{
+public:
+    /// Constructor
+    Chirp(double initial = 100, double rate = 100);
+    inline double sample(double t) const;
+    void sample(const double* t, double* b, int n) const;
+    inline double length() const;
+    inline double peak() const;
+public:
+    double initial; ///< initial frequency in hertz
+    double rate;    ///< frequency ramp rate in hertz per second
+private:
+    TACT_SERIALIZE(TACT_MEMBER(initial), TACT_MEMBER(rate));
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A sine carrier modulated by a sine, sin(2*pi*frequency*t + index*sin(2*pi*modulation*t)), computed in closed form.
+class SYNTACTS_API FmSine
+{
+public:
+    /// Constructor
+    FmSine(double frequency = 100, double modulation = 10, double index = 2.0);
+    inline double sample(double t) const;
+    void sample(const double* t, double* b, int n) const;
+    inline double length() const;
+    inline double peak() const;
+public:
+    double frequency;  ///< carrier frequency in hertz
+    double modulation; ///< modulating frequency in hertz
+    double index;      ///< modulation index
+private:
+    TACT_SERIALIZE(TACT_MEMBER(frequency), TACT_MEMBER(modulation), TACT_MEMBER(index));
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 /// A PWM square wave with adjustable frequency and duty cycle.
 class SYNTACTS_API Pwm
 {
@@ -111,6 +195,7 @@ public:
     Pwm(double frequency = 1.0, double dutyCycle = 0.5);
     inline double sample(double t) const;
     inline double length() const;
+    inline double peak() const;
 public:
     double frequency;
     double dutyCycle;
@@ -120,6 +205,66 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/// Harmonics above this frequency are left out of Wavetable oscillators (Hz).
+constexpr double WAVETABLE_BAND = 20000;
+
+/// An Oscillator that reads one cycle from precomputed, band-limited tables. Each table level keeps
+/// half the harmonics of the one before it (one level per octave), and sampling reads the level whose
+/// highest harmonic stays under WAVETABLE_BAND at the input's frequency, so fast inputs don't alias.
+/// Sampling blocks also keeps it under the Nyquist frequency of the block's time spacing.
+/// Tables of the built-in shapes are built once and shared by every Wavetable in the process.
+class SYNTACTS_API Wavetable : public IOscillator
+{
+public:
+    /// Shapes of the table.
+    enum class Shape {
+        Sine     = 0, ///< sine wave
+        Square   = 1, ///< band-limited square wave (matches Square)
+        Saw      = 2, ///< band-limited saw wave (matches Saw)
+        Triangle = 3, ///< band-limited triangle wave (matches Triangle)
+        Custom   = 4  ///< one cycle of a user Signal
+    };
+    /// Constructs a Wavetable of a built-in shape with a scalar frequency in hertz.
+    Wavetable(Shape shape = Shape::Sine, double hertz = 100);
+    /// Constructs a Wavetable of a built-in shape with a signal based input.
+    Wavetable(Shape shape, Signal x);
+    /// Constructs a Wavetable from one cycle of a finite Signal (e.g. Samples or PolyBezier) sampled over its length.
+    Wavetable(const Signal& cycle, double hertz);
+    /// Constructs a Wavetable from one cycle of a finite Signal with a signal based input.
+    Wavetable(const Signal& cycle, Signal x);
+    double sample(double t) const;
+    /// Samples n times t into buffer b, choosing the table level once per block.
+    void sample(const double* t, double* b, int n) const;
+    /// Returns the largest magnitude in the tables (band-limited edges overshoot slightly).
+    double peak() const;
+    /// Returns the shape of the table.
+    Shape getShape() const;
+public:
+    class Table;
+private:
+    /// Returns the frequency of the input at t in hertz, given its phase there.
+    double hertz(double t, double phase) const;
+    /// Shares the built-in table of m_shape, or builds one from m_cycle.
+    void build();
+private:
+    Shape m_shape;
+    std::vector<float> m_cycle;           ///< Custom cycle resampled to the table size (serialized)
+    std::shared_ptr<const Table> m_table; ///< band-limited levels, shared by copies and never serialized
+private:
+    friend class cereal::access;
+    template <class Archive>
+    void save(Archive& archive) const {
+        archive(TACT_PARENT(IOscillator), TACT_MEMBER(m_shape), TACT_MEMBER(m_cycle));
+    }
+    template <class Archive>
+    void load(Archive& archive) {
+        archive(TACT_PARENT(IOscillator), TACT_MEMBER(m_shape), TACT_MEMBER(m_cycle));
+        build();
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 
 } // namespace tact
 
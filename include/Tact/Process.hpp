@@ -25,10 +25,14 @@
 #pragma once
 
 #include <Tact/Signal.hpp>
+#include <memory>
 
 namespace tact
 {
 
+/// A finite Signal rendered once into a sample buffer (see Repeater::bake and Reverser::bake).
+class BakedSignal;
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /// A Signal which repeats another Signal for a number of repetitions.
@@ -39,12 +43,25 @@ public:
     Repeater(Signal signal, int repetitions, double delay = 0);
     double sample(double t) const;
     double length() const;
+    double peak() const;
+    bool silent(double t0, double t1) const;
+    /// Renders signal once at sampleRate so that sample() indexes the buffer instead of re-evaluating signal.
+    /// Output matches the unbaked Repeater only at on-grid times (e.g. a delay that is a multiple of 1/sampleRate at pitch 1);
+    /// other times are linearly interpolated. Renders again if baked at a different rate, and does nothing if signal is
+    /// infinite or longer than maxSamples at sampleRate (the default is ~43 s at 48 kHz, 8 MB).
+    void bake(double sampleRate, int maxSamples = 1 << 21);
+    /// Discards the baked buffer (call this after modifying signal on a baked Repeater).
+    void unbake();
+    /// Returns true if signal has been baked.
+    bool isBaked() const;
 
 public:
     Signal signal;
     int repetitions;
     double delay;
 
+private:
+    std::shared_ptr<const BakedSignal> m_baked; ///< shared by copies, never serialized
 private:
     TACT_SERIALIZE(TACT_MEMBER(signal), TACT_MEMBER(repetitions), TACT_MEMBER(delay));
 };
@@ -59,6 +76,8 @@ public:
     Stretcher(Signal signal, double factor);
     double sample(double t) const;
     double length() const;
+    double peak() const;
+    bool silent(double t0, double t1) const;
 
 public:
     Signal signal;
@@ -77,12 +96,45 @@ public:
     Reverser(Signal signal);
     double sample(double t) const;
     double length() const;
+    double peak() const;
+    /// Renders signal once at sampleRate so that sample() reads the buffer backwards instead of re-evaluating signal.
+    /// Output matches the unbaked Reverser only if its length is a multiple of 1/sampleRate and it is played at pitch 1;
+    /// other times are linearly interpolated.
+    /// Renders again if baked at a different rate, and does nothing if signal is infinite or longer than maxSamples at sampleRate.
+    void bake(double sampleRate, int maxSamples = 1 << 21);
+    /// Discards the baked buffer (call this after modifying signal on a baked Reverser).
+    void unbake();
+    /// Returns true if signal has been baked.
+    bool isBaked() const;
 public:
     Signal signal;
+private:
+    std::shared_ptr<const BakedSignal> m_baked; ///< shared by copies, never serialized
 private:
     TACT_SERIALIZE(TACT_MEMBER(signal));
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/// A Signal which evaluates another Signal at a control rate and linearly interpolates between,
+/// for slowly changing Signals such as envelopes and LFOs. Block sampling evaluates the Signal
+/// once per control period; sampling one time evaluates it at the two surrounding control times.
+class SYNTACTS_API ControlRate {
+public:
+    ControlRate();
+    ControlRate(Signal signal, double rate = 1000);
+    double sample(double t) const;
+    void sample(const double* t, double* b, int n) const;
+    double length() const;
+    double peak() const;
+    bool silent(double t0, double t1) const;
+public:
+    Signal signal;
+    double rate; ///< evaluations per second (<= 0 samples the Signal directly)
+private:
+    TACT_SERIALIZE(TACT_MEMBER(signal), TACT_MEMBER(rate));
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 } // namespace tact
\ No newline at end of file
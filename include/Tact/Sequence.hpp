@@ -25,7 +25,11 @@
 #pragma once
 
 #include <Tact/Signal.hpp>
+#include <algorithm>
 #include <vector>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 
 namespace tact {
 
@@ -44,6 +48,14 @@ public:
 
     /// Default constructor.
     Sequence();
+    /// Copy constructor.
+    Sequence(const Sequence& other);
+    /// Move constructor.
+    Sequence(Sequence&& other) noexcept;
+    /// Copy assignment.
+    Sequence& operator=(const Sequence& other);
+    /// Move assignment.
+    Sequence& operator=(Sequence&& other) noexcept;
     /// Moves the insertion head forward/backward by t.
     Sequence& push(double t);
     /// Pushes a Signal at the head position and then moves the head forward.
@@ -54,33 +66,101 @@ public:
     Sequence& insert(Signal signal, double t);
     /// Inserts another Sequence at position t in this Sequence but does NOT move head.
     Sequence& insert(Sequence sequence, double t);
+    /// Pushes a shared reference to another Sequence (see SequenceRef) at the head position and then moves the head forward.
+    Sequence& pushNested(Sequence sequence);
+    /// Inserts a shared reference to another Sequence (see SequenceRef) at position t but does NOT move head.
+    Sequence& insertNested(Sequence sequence, double t);
     /// Clears the Sequence
     void clear();
 
     /// Samples and sums all overlapping signals in the sequence at time t.
     double sample(double t) const;
+    /// Samples n times t into buffer b, rendering each overlapping key as a block and skipping gaps and silent keys.
+    void sample(const double* t, double* b, int n) const;
     /// Returns the length of the Sequence.
     double length() const;
+    /// Returns the largest sum of the peaks of keys that overlap in time.
+    double peak() const;
+    /// Returns true if every key overlapping [t0, t1] is silent there.
+    bool silent(double t0, double t1) const;
 
     /// Returns the number of keys in the sequence.
     int keyCount() const;
-    /// Returns a key in the sequence.
+    /// Returns a key in the sequence (keys are ordered by their time).
     const Key& getKey(int idx) const;
 
     /// Moves the insertion head of this Sequence by the specified amount.
-    inline Sequence& operator<<(double rhs);
+    inline Sequence& operator<<(double rhs) &;
     /// Pushes a Signal into this Sequence at the current insertion head.
-    inline Sequence& operator<<(Signal rhs);
+    inline Sequence& operator<<(Signal rhs) &;
     /// Pushes another Sequence into this Sequence at the current insertion head.
-    inline Sequence& operator<<(Sequence rhs);
+    inline Sequence& operator<<(Sequence rhs) &;
+    /// Moves the insertion head of a temporary Sequence (chains move instead of copying).
+    inline Sequence operator<<(double rhs) &&;
+    /// Pushes a Signal into a temporary Sequence (chains move instead of copying).
+    inline Sequence operator<<(Signal rhs) &&;
+    /// Pushes another Sequence into a temporary Sequence (chains move instead of copying).
+    inline Sequence operator<<(Sequence rhs) &&;
 
 public:
     double head; ///< the current insertion head position/time.
 private:
-    std::vector<Key> m_keys; ///< all keys
-    double m_length;         ///< accumulated length
+    /// Inserts a key of known length keeping keys sorted by time.
+    void insertKey(Signal signal, double t, double length);
+    /// Rebuilds end times and the interval index from sorted keys.
+    void rebuildIndex(std::size_t from = 0);
+    /// Finds the range [lo, hi) of keys that may overlap t, starting from the streaming cursor.
+    void findRange(double t, std::size_t& lo, std::size_t& hi) const;
+    /// Finds the range [lo, hi) of keys that may overlap [t0, t1].
+    void findRange(double t0, double t1, std::size_t& lo, std::size_t& hi) const;
 private:
-    TACT_SERIALIZE(TACT_MEMBER(head), TACT_MEMBER(m_keys), TACT_MEMBER(m_length));
+    std::vector<Key> m_keys;        ///< all keys, sorted by time
+    std::vector<double> m_ends;     ///< cached end time of each key
+    std::vector<double> m_maxEnds;  ///< running maximum of m_ends (interval index)
+    double m_length;                ///< accumulated length
+    mutable std::atomic<std::uint64_t> m_cursor; ///< packed [lo,hi) hint of the last sample
+private:
+    friend class cereal::access;
+    template <class Archive>
+    void save(Archive& archive) const {
+        archive(TACT_MEMBER(head), TACT_MEMBER(m_keys), TACT_MEMBER(m_length));
+    }
+    template <class Archive>
+    void load(Archive& archive) {
+        archive(TACT_MEMBER(head), TACT_MEMBER(m_keys), TACT_MEMBER(m_length));
+        std::stable_sort(m_keys.begin(), m_keys.end(), [](const Key& a, const Key& b) { return a.t < b.t; });
+        rebuildIndex();
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A Signal that references an immutable, shared Sequence. Nesting a Sequence this way
+/// costs O(1) regardless of its key count, and copies of the Signal share the same keys. Since the keys are
+/// shared, Session::play does not bake Repeaters or Reversers inside them.
+class SequenceRef {
+public:
+    /// Default constructor.
+    SequenceRef();
+    /// Takes ownership of a Sequence.
+    SequenceRef(Sequence sequence);
+    /// Shares an existing Sequence.
+    SequenceRef(std::shared_ptr<const Sequence> sequence);
+    /// Samples the referenced Sequence.
+    inline double sample(double t) const { return m_sequence->sample(t); }
+    /// Samples the referenced Sequence at n times.
+    inline void sample(const double* t, double* b, int n) const { m_sequence->sample(t, b, n); }
+    /// Returns the length of the referenced Sequence.
+    inline double length() const { return m_sequence->length(); }
+    /// Returns the peak of the referenced Sequence.
+    inline double peak() const { return m_sequence->peak(); }
+    /// Returns true if the referenced Sequence is silent over [t0, t1].
+    inline bool silent(double t0, double t1) const { return m_sequence->silent(t0, t1); }
+    /// Returns the referenced Sequence.
+    const Sequence& get() const;
+private:
+    std::shared_ptr<const Sequence> m_sequence;
+    TACT_SERIALIZE(TACT_MEMBER(m_sequence));
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,66 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Tact/Session.hpp>
+#include <memory>
+#include <string>
+
+namespace tact {
+
+/// Services commands from Client processes through named shared memory and plays them on a Session.
+/// While running, the Server should be the only thread issuing commands to the Session.
+class Server {
+public:
+
+    /// Constructor. The Session must be opened before the Server is started.
+    Server(Session& session, const std::string& name = "syntacts");
+
+    /// Destructor. Stops the Server if it is running.
+    ~Server();
+
+    /// Creates the shared memory region and begins servicing commands on a background thread.
+    int start();
+
+    /// Stops servicing commands and removes the shared memory region.
+    void stop();
+
+    /// Returns true if the Server is running.
+    bool isRunning() const;
+
+    /// Gets the name of the shared memory region.
+    const std::string& getName() const;
+
+    /// Gets the number of commands serviced since the Server was started.
+    std::size_t getCommandCount() const;
+
+private:
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace tact
@@ -30,6 +30,8 @@
 #include <Tact/Sequence.hpp>
 #include <Tact/Operator.hpp>
 #include <Tact/Process.hpp>
+#include <cstdint>
+#include <functional>
 #include <string>
 
 namespace tact {
@@ -66,7 +68,61 @@ struct Device {
     int defaultSampleRate;        ///< the device's default sample rate
 };
 
-/// Encapsulates a Syntacts device Session.
+/// Scheduling policies for the Session audio thread.
+enum class Scheduling {
+    Default    = 0, ///< leave the scheduling chosen by the driver API untouched
+    Fifo       = 1, ///< SCHED_FIFO real-time scheduling (Linux only)
+    RoundRobin = 2  ///< SCHED_RR real-time scheduling (Linux only)
+};
+
+/// Real-time options for the Session audio thread.
+struct RealTime {
+    RealTime();
+    Scheduling scheduling; ///< scheduling policy of the audio thread
+    int priority;          ///< scheduling priority (1-99) when using Fifo or RoundRobin
+    std::vector<int> cpus; ///< CPU cores the audio thread is pinned to (empty for no affinity, Linux only)
+    bool flushDenormals;   ///< enable flush-to-zero/denormals-are-zero in the audio callback (on by default)
+    bool lockMemory;       ///< lock process memory at open and prefault Signal buffers at play (Linux only)
+    double controlRate;    ///< rate envelopes and slow LFOs in played Signals are evaluated at and interpolated from (0 to disable, the default)
+};
+
+/// A voice or channel lifecycle event emitted by the Session audio thread.
+struct Event {
+    /// Event types.
+    enum Type {
+        // voice events are dropped if the event queue is full (see Session::getDroppedEvents)
+        VoiceStarted  = 0, ///< a Signal started playing on a voice
+        VoiceFinished = 1, ///< a voice reached the end of its Signal or was stopped
+        VoiceStolen   = 2, ///< a playing voice was replaced because all voices were busy
+        ChannelIdle   = 3  ///< a channel has no more active voices (delayed rather than dropped if events aren't consumed)
+    };
+    Type type;   ///< the type of event
+    int channel; ///< the channel the event occurred on
+    int voice;   ///< the voice the event occurred on (-1 for channel events)
+    double time; ///< the Session time in seconds at which the event occurred
+};
+
+/// Spatial panning parameters a Session evaluates in its audio thread for a group of channels (see Spatializer).
+struct Panning {
+    Panning();
+    double x, y, z;      ///< target position
+    double radius;       ///< target radius (channels farther away are silent)
+    double kernelX, kernelY, kernelZ; ///< relative extent of the target along each axis (1,1,1 is a sphere)
+    double volume;       ///< gain applied to every channel of the group
+    double wrapX, wrapY; ///< wrapping interval of each axis (0 disables wrapping)
+    Curve rollOff;       ///< roll-off applied to 1 - distance / radius
+    int nearest;         ///< if > 0, only the nearest channels sound, with constant power gains instead of roll-off
+};
+
+/// Target motion given as Signals of time, which a Session evaluates in its audio thread in place of the Panning position.
+struct Trajectory {
+    Trajectory();
+    Signal x, y;         ///< target position over time
+    Signal radius;       ///< target radius over time (used if hasRadius is true)
+    bool hasRadius;
+};
+
+/// Encapsulates a Syntacts device Session. Commands return SyntactsError_QueueFull if the audio thread falls behind.
 class Session {
 public:
 
@@ -100,54 +156,137 @@ public:
     /// Closes the currently opened device.
     int close();
 
+    /// Sets the real-time options of the audio thread. Must be called before the Session is opened.
+    int setRealTime(const RealTime& options);
+
+    /// Gets the real-time options of the audio thread.
+    const RealTime& getRealTime() const;
+
     /// Returns true if a device is open, false otherwise.
     bool isOpen() const;
 
     /// Plays a signal on the specified channel of the current device.
     int play(int channel, Signal signal);
 
+    /// Plays a signal on the specified channel at a sample-accurate Session time (see getTime).
+    int play(int channel, Signal signal, double time);
+
     /// Returns true if a signal is playing on the specified channel.
     bool isPlaying(int channel);
 
     /// Plays a signal on all available channels of the current device.
     int playAll(Signal signal);
 
+    /// Bakes Repeaters and Reversers in a signal at the current sample rate ahead of play, which only bakes short ones (~1.4 s at 48 kHz).
+    /// Modifies the signal in place, and must be called again if the Session is reopened at a different sample rate.
+    int prepare(Signal& signal);
+
     /// Stops playing signals on the specified channel of the current device.
     int stop(int channel);
 
+    /// Stops playing signals on the specified channel at a sample-accurate Session time.
+    int stop(int channel, double time);
+
     /// Stops playing signals on all channels.
     int stopAll();
 
     /// Pauses playing signals on the specified channel of the current device.
     int pause(int channel);
 
+    /// Pauses playing signals on the specified channel at a sample-accurate Session time.
+    int pause(int channel, double time);
+
     /// Pauses playing signals on all channels.
     int pauseAll();
 
     /// Returns true if the specified channel is in a paused state.
     bool isPaused(int channel);
 
+    /// Pops the next pending Event emitted by the audio thread. Returns false if there are none.
+    bool pollEvent(Event& event);
+
+    /// Returns the number of voice Events dropped since the Session was opened because events weren't consumed fast enough.
+    std::uint64_t getDroppedEvents() const;
+
+    /// Sets a function called for every Event from a Session owned thread (pollEvent is unused while set).
+    void setEventCallback(std::function<void(const Event&)> callback);
+
     /// Resumes playing signals on the specified channel of the current device.
     int resume(int channel);
 
+    /// Resumes playing signals on the specified channel at a sample-accurate Session time.
+    int resume(int channel, double time);
+
     /// Resumes playing signals on all channels.
     int resumeAll();
 
     /// Sets the volume on the specified channel of the current device.
     int setVolume(int channel, double volume);
 
+    /// Sets the volume on the specified channel at a sample-accurate Session time.
+    int setVolume(int channel, double volume, double time);
+
     /// Gets the volume on the specified channel of the current device.
     double getVolume(int channel);
 
     /// Sets the pitch on the specified channel of the current device.
     int setPitch(int channel, double pitch);
 
+    /// Sets the pitch on the specified channel at a sample-accurate Session time.
+    int setPitch(int channel, double pitch, double time);
+
     /// Gets the pitch on the specified channel of the current device.
     double getPitch(int channel);
 
     /// Gets the max output level between 0 and 1 for the most recent buffer (useful for visualizations).
     double getLevel(int channel);
 
+    /// Reserves a spatial panner evaluated by the audio thread and returns its id (SyntactsError_InvalidPanner if none are free).
+    int openPanner();
+
+    /// Releases a spatial panner and restores unit spatial gain on its channels.
+    int closePanner(int panner);
+
+    /// Uploads the channels of a panner with their positions and calibration gains, replacing any previous ones (empty z is flat, empty gains are unity).
+    int setPannerChannels(int panner, const std::vector<int>& channels, const std::vector<double>& x, const std::vector<double>& y, 
+                          const std::vector<double>& z = {}, const std::vector<double>& gains = {});
+
+    /// Sets the parameters of a panner, interpolated per sample over the rest of the next buffer.
+    int setPanning(int panner, const Panning& panning);
+
+    /// Sets the parameters of a panner at a sample-accurate Session time.
+    int setPanning(int panner, const Panning& panning, double time);
+
+    /// Plays a Signal on a panner source, which is mixed into the panner's channels with gains from the source's own Panning.
+    int playSource(int panner, int source, Signal signal);
+
+    /// Stops a panner source.
+    int stopSource(int panner, int source);
+
+    /// Sets the position, radius, volume and roll-off of a panner source, interpolated per sample over the rest of the next buffer.
+    int setSourcePanning(int panner, int source, const Panning& panning);
+
+    /// Sets the position, radius, volume and roll-off of a panner source at a sample-accurate Session time.
+    int setSourcePanning(int panner, int source, const Panning& panning, double time);
+
+    /// Moves the target of a panner along a Trajectory starting now, until cleared.
+    int setTrajectory(int panner, const Trajectory& trajectory);
+
+    /// Moves the target of a panner along a Trajectory starting at a sample-accurate Session time.
+    int setTrajectory(int panner, const Trajectory& trajectory, double time);
+
+    /// Returns the target of a panner to its Panning position.
+    int clearTrajectory(int panner);
+
+    /// Moves a panner source along a Trajectory starting now, until cleared.
+    int setSourceTrajectory(int panner, int source, const Trajectory& trajectory);
+
+    /// Moves a panner source along a Trajectory starting at a sample-accurate Session time.
+    int setSourceTrajectory(int panner, int source, const Trajectory& trajectory, double time);
+
+    /// Returns a panner source to its Panning position.
+    int clearSourceTrajectory(int panner, int source);
+
     /// Gets info for the currently opened device.
     const Device& getCurrentDevice() const;
 
@@ -166,6 +305,18 @@ public:
     /// Returns the CPU core load (0 to 1) of the Session.
     double getCpuLoad() const;
 
+    /// Returns the Session time in seconds, i.e. the number of frames rendered since the device was opened over the sample rate.
+    double getTime() const;
+
+    /// Starts recording the rendered output of all channels to a 32-bit float WAV (.wav) or raw interleaved float file.
+    int startRecording(const std::string& filePath);
+
+    /// Stops recording and finalizes the file (also called by close). Returns SyntactsError_FileError if a write failed.
+    int stopRecording();
+
+    /// Returns true if the Session is recording.
+    bool isRecording() const;
+
     /// Opens the control panel of a device if supported.
     void openControlPanel(int index);
 
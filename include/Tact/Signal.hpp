@@ -47,17 +47,30 @@ public:
     inline double sample(double t) const;
     /// Samples the Signal at n times give by t into output buffer b.
     inline void sample(const double* t, double* b, int n) const;
-    /// Returns the length of the Signal in seconds or infinity.
+    /// Returns the length of the Signal in seconds or infinity (cached when the Signal is created, see refresh).
     inline double length() const;
+    /// Returns true if the Signal has a finite length.
+    inline bool finite() const;
+    /// Returns an upper bound on the magnitude of the Signal's samples, or infinity if unknown (cached when the Signal is created, see refresh).
+    inline double peak() const;
+    /// Returns true if the Signal is known to be zero at every time in [t0, t1] (false if unknown).
+    inline bool silent(double t0, double t1) const;
 
     /// Returns the type_index of the underlying type-erased Signal.
     std::type_index typeId() const;
     /// Returns true if the underlying type-erased Signal is type T.
     template <typename T> inline bool isType() const;
-    /// Gets a pointer to the underlying type-erased Signal type (use with caution).
+    /// Gets a pointer to the underlying type-erased Signal type for reading (modifying it leaves cached length and peak stale).
     void* get() const;
-    /// Gets a pointer to the underlying type-erased Signal, cast as type T (use with caution and only if you know the Signal is a T!).
+    /// Gets a pointer to the underlying type-erased Signal type for modifying (use with caution, stops caching length and peak until refresh).
+    void* get();
+    /// Gets a pointer to the underlying type-erased Signal, cast as type T, for reading (only if you know the Signal is a T!).
     template <typename T> inline T* getAs() const;
+    /// Gets a pointer to the underlying type-erased Signal, cast as type T, for modifying (use with caution, stops caching length and peak until refresh).
+    template <typename T> inline T* getAs();
+    /// Caches length and peak again after the Signal, or a Signal it holds, was modified through get or getAs.
+    /// Signals holding a modified Signal are refreshed after it, from the inside out.
+    void refresh();
     
     /// Returns the current count of Signals allocated in this process.
     static inline int count();
@@ -100,8 +113,12 @@ public:
         virtual double sample(double t) const = 0;
         virtual void sample(const double* t, double* b, int n, double s, double o) const = 0;
         virtual double length() const = 0;
+        virtual double peak() const = 0;
+        virtual bool silent(double t0, double t1) const = 0;
         virtual std::type_index typeId() const = 0;
         virtual void* get() const = 0;
+        /// Sets out to the equivalent runtime Signal of a static (st) Signal or a type kept to load old archives and returns true, or returns false.
+        virtual bool runtime(Signal&) const { return false; }
 #ifndef SYNTACTS_USE_SHARED_PTR
 #ifdef SYNTACTS_USE_POOL
         virtual std::unique_ptr<Concept, Deleter> copy() const = 0;
@@ -123,8 +140,11 @@ public:
         double sample(double t) const override;
         void sample(const double* t, double* b, int n, double s, double o) const override;
         double length() const override;
+        double peak() const override;
+        bool silent(double t0, double t1) const override;
         std::type_index typeId() const override;
         void* get() const override;
+        bool runtime(Signal& out) const override;
 #ifndef SYNTACTS_USE_SHARED_PTR
 #ifdef SYNTACTS_USE_POOL
         std::unique_ptr<Concept, Deleter> copy() const override;
@@ -159,6 +179,12 @@ private:
     std::unique_ptr<Concept> m_ptr;
 #endif
 #endif
+#ifndef SYNTACTS_USE_SHARED_PTR
+    // not cached with shared pointers, since a copy sharing the model could edit it through get() and stale the cache.
+    // Caches are only written by non-const members, so const Signals may be read from any number of threads.
+    double m_length = NAN; ///< cached length of the type-erased Signal (NaN if stale)
+    double m_peak   = NAN; ///< cached peak of the type-erased Signal (NaN if stale)
+#endif
 private:
     friend class cereal::access;
     template <class Archive> void save(Archive& archive) const;
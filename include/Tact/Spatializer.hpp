@@ -29,13 +29,55 @@
 namespace tact
 {
 
+/// Uniform grid over channel positions used to find the channels near a spatial target.
+class SYNTACTS_API SpatialIndex {
+public:
+    /// Constructor.
+    SpatialIndex();
+
+    /// Builds the index over positions stored as separate x, y and z arrays of equal size (z may be empty for 2D).
+    void build(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z = {});
+    /// Gets the indices of positions that may lie within rx, ry and rz of (x,y,z) on each axis, without duplicates. Wrap intervals of zero disable wrapping.
+    void query(double x, double y, double z, double rx, double ry, double rz, double wrapX, double wrapY, std::vector<int>& out);
+    /// Gets the indices of all positions.
+    void queryAll(std::vector<int>& out);
+    /// Returns true if position k was returned by the most recent query.
+    bool queried(int k) const { return m_stamps[k] == m_epoch; }
+
+    /// Gets the number of indexed positions.
+    int size() const { return (int)m_x.size(); }
+    /// Gets the x coordinate of position k.
+    double x(int k) const { return m_x[k]; }
+    /// Gets the y coordinate of position k.
+    double y(int k) const { return m_y[k]; }
+    /// Gets the z coordinate of position k.
+    double z(int k) const { return m_z[k]; }
+
+private:
+    /// Gets the stamp for a new query.
+    void nextEpoch();
+    /// Adds the positions in the cells overlapping the box of half-widths rx, ry and rz around (x,y,z).
+    void gather(double x, double y, double z, double rx, double ry, double rz, std::vector<int>& out);
+    /// Gets the cell containing position k.
+    int cellOf(int k) const;
+
+    std::vector<double> m_x, m_y, m_z; ///< positions
+    std::vector<int> m_cellStart;      ///< offsets of each cell into m_items (plus end)
+    std::vector<int> m_items;          ///< position indices sorted by cell
+    std::vector<unsigned int> m_stamps; ///< epoch at which each position was last returned
+    unsigned int m_epoch;
+    double m_min[3], m_max[3];         ///< bounds on each axis
+    double m_inv[3];                   ///< inverse cell size on each axis
+    int m_cells[3];                    ///< cell count on each axis
+};
+
 /// Syntacts Spatializer interface.
 class SYNTACTS_API Spatializer {
 public:
 
-    // 2D Spatializer point
+    // Spatializer point (z is zero for 2D layouts)
     struct Point {
-        double x,y;
+        double x,y,z = 0;
     };
 
     /// Constructor.
@@ -49,14 +91,18 @@ public:
     void unbind();
 
     /// Set the position of a channel. The channel will be added if it's not already in the Spatializer.
-    void setPosition(int channel, double x, double y = 0);
+    void setPosition(int channel, double x, double y = 0, double z = 0);
     /// Set the position of a channel. The channel will be added if it's not already in the Spatializer.
     void setPosition(int channel, const Point& p);
     /// Gets the position of a channel if it is in the Spatializer.
     Point getPosition(int channel) const;
+    /// Set the calibration gain of a channel, applied to everything the Spatializer plays on it (1 by default).
+    void setCalibration(int channel, double gain);
+    /// Get the calibration gain of a channel.
+    double getCalibration(int channel) const;
 
     /// Set the Spatialier target position.
-    void setTarget(double x, double y = 0);
+    void setTarget(double x, double y = 0, double z = 0);
     /// Set the Spatialier target position.
     void setTarget(const Point& p);
     /// Get the Spatializer target position.
@@ -69,12 +115,28 @@ public:
     void setRollOff(Curve rollOff);
     /// Get the Spatializer target roll-off method.
     Curve getRollOff() const;
+    /// Set the relative extent of the target and sources along each axis, making their radius an ellipsoid (1,1,1 is a sphere).
+    void setKernel(double x, double y, double z = 1);
+    /// Get the relative extent of the target along each axis.
+    const Point& getKernel() const;
+    /// Restrict the target and sources to their k nearest channels with constant power gains (VBAP-style), or 0 for distance roll-off.
+    void setNearest(int k);
+    /// Get the number of nearest channels the target is restricted to (0 for distance roll-off).
+    int getNearest() const;
     /// Enable Spatializer wrapping for one or both axes. A value of zero disables wrapping.
     void setWrap(double xInterval, double yInterval);
     /// Enable Spatializer wrapping for one or both axes. A value of zero disables wrapping.
     void setWrap(const Point& wrapInterval);
     /// Get Spatializer wrapping intervals. 0s indicate wrapping is disabled.
     const Point& getWrap() const;
+    /// Move the target along x(t) and y(t) Signals evaluated by the Session audio thread, overriding the target position until cleared.
+    void setTrajectory(Signal x, Signal y);
+    /// Move the target along x(t) and y(t) and vary its radius along r(t), evaluated by the Session audio thread.
+    void setTrajectory(Signal x, Signal y, Signal r);
+    /// Return the target to its set position.
+    void clearTrajectory();
+    /// Returns true if the target is following a trajectory.
+    bool hasTrajectory() const;
 
     /// Quickly create a grid of channels.
     bool createGrid(int rows, int cols);
@@ -91,9 +153,40 @@ public:
 
     /// Play a Signal on the Spatializer.
     void play(Signal signal);   
-    /// Stop all Signals playing in the Spatializer.
+    /// Stop all Signals playing in the Spatializer, including sources.
     void stop();
 
+    /// Add a source that plays a Signal at its own position, mixed into the Spatializer channels by the Session. Returns the source id, or SyntactsError_InvalidSource if all are in use.
+    int addSource(Signal signal, double x = 0.5, double y = 0.5);
+    /// Play a new Signal on a source.
+    void playSource(int source, Signal signal);
+    /// Remove a source and stop its Signal.
+    void removeSource(int source);
+    /// Set the position of a source.
+    void setSourcePosition(int source, double x, double y = 0, double z = 0);
+    /// Get the position of a source.
+    Point getSourcePosition(int source) const;
+    /// Set the radius of a source.
+    void setSourceRadius(int source, double r);
+    /// Get the radius of a source.
+    double getSourceRadius(int source) const;
+    /// Set the volume of a source.
+    void setSourceVolume(int source, double volume);
+    /// Get the volume of a source.
+    double getSourceVolume(int source) const;
+    /// Set the roll-off method of a source.
+    void setSourceRollOff(int source, Curve rollOff);
+    /// Move a source along x(t) and y(t) Signals evaluated by the Session audio thread, overriding its position until cleared.
+    void setSourceTrajectory(int source, Signal x, Signal y);
+    /// Move a source along x(t) and y(t) and vary its radius along r(t), evaluated by the Session audio thread.
+    void setSourceTrajectory(int source, Signal x, Signal y, Signal r);
+    /// Return a source to its set position.
+    void clearSourceTrajectory(int source);
+    /// Get the number of sources in the Spatializer.
+    int getSourceCount() const;
+    /// Returns true if a source is in the Spatializer.
+    bool hasSource(int source) const;
+
     /// Set the global volume of the Spatializer.
     void setVolume(double volume);
     /// Get the global volume of the Spatializer.
@@ -104,10 +197,12 @@ public:
     /// Get the global pitch of the Spatializer.
     double getPitch() const;
 
-    /// Enable/disable automatic updating of pitch/volume of all channels when Spatializer target or channels change (enabled by default).
+    /// Enable/disable automatic updating of the Session panner when Spatializer target or channels change (enabled by default).
     void autoUpdate(bool enable);
-    /// Explicitly update the pitch/volume of all channels in the Spatializer.
+    /// Explicitly send the Spatializer target, radius, volume and roll-off to the Session, which interpolates them per sample.
     void update();
+    /// Explicitly send the Spatializer parameters to the Session at a sample-accurate Session time.
+    void update(double time);
     
 private:
     Session* m_session;
@@ -119,6 +214,37 @@ private:
     bool m_autoUpdate;
     Point m_wrapInterval;
     std::map<int,Point> m_positions;
+    std::map<int,double> m_calibration;
+    Point m_kernel;
+    int m_nearest;
+    int m_panner;  ///< Session panner evaluating this Spatializer
+    bool m_dirty;  ///< true if channel positions need to be uploaded
+    Trajectory m_trajectory;
+    bool m_moving;     ///< true if the target follows m_trajectory
+    bool m_motionSent; ///< true if m_trajectory has been sent to the Session
+
+    /// Signal mixed into the Spatializer channels at its own position
+    struct Source {
+        Point position;
+        double radius;
+        double volume;
+        Curve rollOff;
+        Signal signal;
+        bool playing;  ///< true if the Signal should be playing
+        bool started;  ///< true if the Signal has been sent to the Session
+        bool dirty;    ///< true if the source panning needs to be sent
+        Trajectory trajectory;
+        bool moving;     ///< true if the source follows its trajectory
+        bool motionSent; ///< true if the trajectory has been sent to the Session
+    };
+    std::map<int,Source> m_sources;
+
+    /// Marks a source changed and updates if enabled
+    void touch(int source);
+    /// Marks the target trajectory unsent and updates if enabled
+    void move();
+    /// Marks a source trajectory unsent and updates if enabled
+    void move(int source);
 };
     
 } // namespace tact
@@ -0,0 +1,207 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+
+#pragma once
+
+#include <Tact/Signal.hpp>
+#include <Tact/General.hpp>
+#include <Tact/Operator.hpp>
+#include <Tact/Oscillator.hpp>
+
+namespace tact
+{
+
+/// Signals composed at compile time. A whole st expression is one concrete type the compiler can 
+/// inline, type-erased only once when it is converted to a Signal. Expressions sample like the 
+/// runtime Signals they mirror and are saved as those Signals, so they load as ordinary Signals.
+namespace st
+{
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// Base of static Signal expressions, used to select the static operators.
+template <typename E>
+struct Expr {
+    /// Returns this expression as its concrete type.
+    inline const E& self() const;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A static Signal that returns the time passed to it.
+struct Time : Expr<Time> {
+    inline double sample(double t) const;
+    inline double length() const;
+    /// Returns the equivalent runtime Signal.
+    inline Signal runtime() const;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A static Signal that emits a constant value over time.
+struct Scalar : Expr<Scalar> {
+    inline Scalar(double value = 1);
+    inline double sample(double t) const;
+    inline double length() const;
+    inline Signal runtime() const;
+public:
+    double value;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A static Signal that increases or decreases over time.
+struct Ramp : Expr<Ramp> {
+    inline Ramp(double initial = 1, double rate = 0);
+    inline Ramp(double initial, double final, double duration);
+    inline double sample(double t) const;
+    inline double length() const;
+    inline Signal runtime() const;
+public:
+    double initial;
+    double rate;
+    double duration;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A runtime Signal used in a static expression (e.g. an Envelope), sampled through the Signal as usual.
+struct Runtime : Expr<Runtime> {
+    inline Runtime(Signal signal);
+    inline double sample(double t) const;
+    inline double length() const;
+    inline Signal runtime() const;
+public:
+    Signal signal;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A static expression scaled and offset, e * gain + bias.
+template <typename E>
+struct Affine : Expr<Affine<E>> {
+    inline Affine(E e, double gain = 1, double bias = 0);
+    inline double sample(double t) const;
+    inline double length() const;
+    inline Signal runtime() const;
+public:
+    E e;
+    double gain;
+    double bias;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// Waveforms of static Oscillators, applied to the phase.
+namespace shape {
+    struct Sine     { static inline double apply(double phase); static inline Signal runtime(Signal x); };
+    struct Square   { static inline double apply(double phase); static inline Signal runtime(Signal x); };
+    struct Saw      { static inline double apply(double phase); static inline Signal runtime(Signal x); };
+    struct Triangle { static inline double apply(double phase); static inline Signal runtime(Signal x); };
+} // namespace shape
+
+/// A static Oscillator whose phase is omega * x(t).
+template <typename Shape, typename X = Time>
+struct Oscillator : Expr<Oscillator<Shape, X>> {
+    /// Constructs an Oscillator with a frequency in hertz, advancing with x (time by default).
+    inline Oscillator(double hertz, X x = X());
+    /// Constructs an Oscillator with x as its phase input.
+    inline Oscillator(X x);
+    inline double sample(double t) const;
+    inline double length() const;
+    inline Signal runtime() const;
+public:
+    X x;          ///< the Oscillator's input
+    double omega; ///< scale of the input in radians
+};
+
+/// A static sine wave Oscillator.
+template <typename X = Time> using Sine     = Oscillator<shape::Sine, X>;
+/// A static square wave Oscillator.
+template <typename X = Time> using Square   = Oscillator<shape::Square, X>;
+/// A static saw wave Oscillator.
+template <typename X = Time> using Saw      = Oscillator<shape::Saw, X>;
+/// A static triangle wave Oscillator.
+template <typename X = Time> using Triangle = Oscillator<shape::Triangle, X>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// Binary operations of static Operators.
+namespace op {
+    struct Add      { static inline double apply(double a, double b); static inline double length(double a, double b); static inline Signal runtime(Signal a, Signal b); };
+    struct Subtract { static inline double apply(double a, double b); static inline double length(double a, double b); static inline Signal runtime(Signal a, Signal b); };
+    struct Multiply { static inline double apply(double a, double b); static inline double length(double a, double b); static inline Signal runtime(Signal a, Signal b); };
+} // namespace op
+
+/// A static Signal which is the result of operating on two other static Signals.
+template <typename Op, typename L, typename R>
+struct Operator : Expr<Operator<Op, L, R>> {
+    inline Operator(L lhs, R rhs);
+    inline double sample(double t) const;
+    inline double length() const;
+    inline Signal runtime() const;
+public:
+    L lhs;
+    R rhs;
+};
+
+/// A static Signal which is the sum of two other static Signals.
+template <typename L, typename R> using Sum        = Operator<op::Add, L, R>;
+/// A static Signal which is the difference of two other static Signals.
+template <typename L, typename R> using Difference = Operator<op::Subtract, L, R>;
+/// A static Signal which is the product of two other static Signals.
+template <typename L, typename R> using Product    = Operator<op::Multiply, L, R>;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// Add two static Signals.
+template <typename L, typename R> inline Sum<L, R> operator+(const Expr<L>& lhs, const Expr<R>& rhs);
+/// Add a static Signal and a scalar.
+template <typename E> inline auto operator+(const Expr<E>& lhs, double rhs);
+/// Add a scalar and a static Signal.
+template <typename E> inline auto operator+(double lhs, const Expr<E>& rhs);
+
+/// Subtract two static Signals.
+template <typename L, typename R> inline Difference<L, R> operator-(const Expr<L>& lhs, const Expr<R>& rhs);
+/// Subtract a scalar from a static Signal.
+template <typename E> inline auto operator-(const Expr<E>& lhs, double rhs);
+/// Subtract a static Signal from a scalar.
+template <typename E> inline auto operator-(double lhs, const Expr<E>& rhs);
+/// Negate a static Signal.
+template <typename E> inline auto operator-(const Expr<E>& lhs);
+
+/// Multiply two static Signals.
+template <typename L, typename R> inline Product<L, R> operator*(const Expr<L>& lhs, const Expr<R>& rhs);
+/// Multiply a static Signal and a scalar.
+template <typename E> inline auto operator*(const Expr<E>& lhs, double rhs);
+/// Multiply a scalar and a static Signal.
+template <typename E> inline auto operator*(double lhs, const Expr<E>& rhs);
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace st
+} // namespace tact
+
+#include <Tact/Detail/Static.inl>
@@ -0,0 +1,161 @@
+// MIT License
+//
+// Copyright (c) 2020 Mechatronics and Haptic Interfaces Lab
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Author(s): Evan Pezent (epezent@rice.edu)
+
+#pragma once
+
+#include <Tact/Session.hpp>
+#include <Tact/Spatializer.hpp>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+namespace tact {
+
+/// Default UDP port of the Syntacts control protocol.
+constexpr int SYNTACTS_UDP_PORT = 6800;
+
+/// Receives batched, timestamped control datagrams over UDP and applies them sample-accurately to a Session.
+///
+/// Every datagram carries a single timestamp on the sender's clock shared by all of its messages.
+/// The Server maps sender time to Session time per sender (tracking the minimum observed offset)
+/// and adds a fixed latency so that batches land on the same sample despite network jitter.
+/// A timestamp of zero applies the batch as soon as possible. While running, the Server should be
+/// the only thread issuing commands to the Session. The protocol is unauthenticated, so the Server
+/// only accepts local datagrams unless it is explicitly bound to another address.
+class UdpServer {
+public:
+
+    /// Constructor. The Session must be opened before the Server is started. Address is the IPv4 address
+    /// to bind ("0.0.0.0" accepts datagrams from any host).
+    UdpServer(Session& session, int port = SYNTACTS_UDP_PORT, const std::string& address = "127.0.0.1");
+
+    /// Destructor. Stops the Server if it is running.
+    ~UdpServer();
+
+    /// Binds the port and begins receiving datagrams on a background thread.
+    int start();
+
+    /// Stops receiving datagrams and closes the port.
+    void stop();
+
+    /// Returns true if the Server is running.
+    bool isRunning() const;
+
+    /// Gets the IPv4 address the Server binds.
+    const std::string& getAddress() const;
+
+    /// Sets the latency in seconds added to timestamped batches to absorb network jitter (default 0.005).
+    void setLatency(double latency);
+
+    /// Gets the latency in seconds added to timestamped batches.
+    double getLatency() const;
+
+    /// Registers a Spatializer addressed by id in target messages. Its automatic updating is disabled.
+    void addSpatializer(int id, Spatializer& spatializer);
+
+    /// Unregisters a Spatializer.
+    void removeSpatializer(int id);
+
+    /// Gets the number of messages applied since the Server was started.
+    std::size_t getMessageCount() const;
+
+    /// Gets the number of datagrams received since the Server was started.
+    std::size_t getDatagramCount() const;
+
+private:
+    UdpServer(const UdpServer&) = delete;
+    UdpServer& operator=(const UdpServer&) = delete;
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/// Reference client for the Syntacts UDP control protocol. Messages are batched until send() is called.
+class UdpClient {
+public:
+
+    /// Constructor.
+    UdpClient();
+
+    /// Destructor.
+    ~UdpClient();
+
+    /// Connects to a UdpServer at an IPv4 address and port.
+    int connect(const std::string& address = "127.0.0.1", int port = SYNTACTS_UDP_PORT);
+
+    /// Closes the socket.
+    void disconnect();
+
+    /// Returns true if the client socket is open.
+    bool isConnected() const;
+
+    /// Sets the timestamp (on the clock of now()) shared by all messages in the current batch. Zero applies them immediately.
+    void setTime(double time);
+
+    /// Queues a Signal to play on a channel.
+    int play(int channel, const Signal& signal);
+
+    /// Queues a Signal from the server's Syntacts Library to play on a channel.
+    int playLibrary(int channel, const std::string& name);
+
+    /// Queues a stop on a channel.
+    int stop(int channel);
+
+    /// Queues a stop on all channels.
+    int stopAll();
+
+    /// Queues a pause on a channel.
+    int pause(int channel);
+
+    /// Queues a resume on a channel.
+    int resume(int channel);
+
+    /// Queues a volume change on a channel.
+    int setVolume(int channel, double volume);
+
+    /// Queues a pitch change on a channel.
+    int setPitch(int channel, double pitch);
+
+    /// Queues a target change on a Spatializer registered with the server.
+    int setTarget(int spatializer, double x, double y);
+
+    /// Queues a ping the server answers as soon as it is received (see receivePong).
+    int ping(std::uint32_t id);
+
+    /// Sends the current batch as one datagram and begins a new batch. Large batches are split automatically.
+    int send();
+
+    /// Waits up to timeout seconds for a ping reply. Returns false if none arrived.
+    bool receivePong(std::uint32_t& id, double& roundTrip, double timeout = 1.0);
+
+    /// Returns the sender clock in seconds used for batch timestamps.
+    static double now();
+
+private:
+    UdpClient(const UdpClient&) = delete;
+    UdpClient& operator=(const UdpClient&) = delete;
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace tact
@@ -37,6 +37,7 @@ constexpr double PI      = 3.14159265358979323846;
 constexpr double HALF_PI = 0.5 * PI;
 constexpr double TWO_PI  = 2.0 * PI;
 constexpr double INV_PI  = 1.0 / PI;
+constexpr double SQRT2   = 1.41421356237309504880;
 constexpr double INF     = std::numeric_limits<double>::infinity();
 constexpr double EPS     = std::numeric_limits<double>::epsilon();
 
@@ -81,8 +82,9 @@ class Signal;
 /// Returns the string name of a Signal
 const std::string& signalName(const Signal& signal); 
 
-/// Recurse a signal for embedded signals and calls func on each
-void recurseSignal(const Signal& signal, std::function<void(const Signal&, int depth)> func);
+/// Recurse a signal for embedded signals and calls func on each. Signals shared with other copies (SequenceRef) are
+/// skipped unless shared is true, in which case func must not modify them.
+void recurseSignal(const Signal& signal, std::function<void(const Signal&, int depth)> func, bool shared = true);
 
 ///////////////////////////////////////////////////////////////////////////////
 
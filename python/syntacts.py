@@ -748,7 +748,7 @@ class Library:
         return _tact.Library_exportSignal(signal._handle, c_char_p(filePath.encode()), format, sampleRate, maxLength)
 
     @staticmethod
-    def import_signal(filePath, format=0, sampleRate=48000):
+    def import_signal(filePath, format=0, sampleRate=0):
         '''Imports a Signal of a specific file format.'''
         handle = _tact.Library_importSignal(c_char_p(filePath.encode()), format, sampleRate)
         if handle:
@@ -0,0 +1,102 @@
+#include <syntacts>
+#include <Tact/Server.hpp>
+#include <Tact/Udp.hpp>
+#include <csignal>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+
+using namespace tact;
+
+namespace {
+
+std::atomic<bool> g_quit(false);
+
+void onInterrupt(int) {
+    g_quit = true;
+}
+
+void printUsage() {
+    std::cout << "usage: syntacts-server [-d device] [-c channels] [-r sample_rate] [-n name] [-p priority] [-u udp_port]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char const *argv[])
+{
+    int device = -1, channels = 0, priority = 0, udpPort = 0;
+    double sampleRate = 0;
+    std::string name = "syntacts";
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "-d") == 0 && hasValue)
+            device = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "-c") == 0 && hasValue)
+            channels = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "-r") == 0 && hasValue)
+            sampleRate = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "-n") == 0 && hasValue)
+            name = argv[++i];
+        else if (std::strcmp(argv[i], "-p") == 0 && hasValue)
+            priority = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "-u") == 0 && hasValue)
+            udpPort = std::atoi(argv[++i]);
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    Session session;
+
+    if (priority > 0) {
+        RealTime rt;
+        rt.scheduling = Scheduling::Fifo;
+        rt.priority = priority;
+        session.setRealTime(rt);
+    }
+
+    int result;
+    if (device < 0)
+        result = session.open();
+    else if (channels > 0 && sampleRate > 0)
+        result = session.open(device, channels, sampleRate);
+    else
+        result = session.open(device);
+    if (result != SyntactsError_NoError) {
+        std::cout << "Failed to open device (error " << result << ")" << std::endl;
+        return 1;
+    }
+
+    // the UDP listener replaces the shared memory server since a Session takes commands from one thread
+    Server server(session, name);
+    UdpServer udp(session, udpPort);
+    result = udpPort > 0 ? udp.start() : server.start();
+    if (result != SyntactsError_NoError) {
+        std::cout << "Failed to start server (error " << result << ")" << std::endl;
+        return 1;
+    }
+
+    const Device& dev = session.getCurrentDevice();
+    std::cout << "Serving " << dev.name << " (" << dev.apiName << ") as ";
+    if (udpPort > 0)
+        std::cout << "UDP port " << udpPort;
+    else
+        std::cout << "\"" << name << "\"";
+    std::cout << " with "
+              << session.getChannelCount() << " channels at " << session.getSampleRate() << " Hz" << std::endl;
+    std::cout << "Press Ctrl+C to quit" << std::endl;
+
+    std::signal(SIGINT, onInterrupt);
+    std::signal(SIGTERM, onInterrupt);
+    while (!g_quit)
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    server.stop();
+    udp.stop();
+    session.close();
+    std::cout << "Serviced " << (udpPort > 0 ? udp.getMessageCount() : server.getCommandCount()) << " commands" << std::endl;
+    return 0;
+}
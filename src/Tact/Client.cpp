@@ -0,0 +1,129 @@
+#include <Tact/Client.hpp>
+#include <Tact/Library.hpp>
+#include "Tact/SharedMemory.hpp"
+#include <cstring>
+
+namespace tact {
+
+class Client::Impl {
+public:
+
+    Impl() : m_region(nullptr) { }
+
+    int connect(const std::string& name) {
+        disconnect();
+        if (!m_mapping.open(name, sizeof(shm::Region)))
+            return SyntactsError_NotConnected;
+        auto region = static_cast<shm::Region*>(m_mapping.data());
+        if (region->magic.load(std::memory_order_acquire) != shm::MAGIC || region->version != shm::VERSION) {
+            m_mapping.close();
+            return SyntactsError_NotConnected;
+        }
+        m_region = region;
+        return SyntactsError_NoError;
+    }
+
+    void disconnect() {
+        m_mapping.close();
+        m_region = nullptr;
+    }
+
+    bool connected() const {
+        return m_region != nullptr && m_region->magic.load(std::memory_order_relaxed) == shm::MAGIC;
+    }
+
+    int send(shm::Op op, int channel, double value = 0, const char* payload = nullptr, std::size_t size = 0) {
+        if (!connected())
+            return SyntactsError_NotConnected;
+        if (size > shm::PAYLOAD_SIZE)
+            return SyntactsError_SignalTooLarge;
+        if (op != shm::OpStopAll && !(channel >= 0 && channel < m_region->channelCount))
+            return SyntactsError_InvalidChannel;
+        std::uint64_t position;
+        shm::Slot* slot = shm::claim(m_region, position);
+        if (!slot)
+            return SyntactsError_QueueFull;
+        slot->op      = op;
+        slot->channel = channel;
+        slot->value   = value;
+        slot->size    = static_cast<std::uint32_t>(size);
+        if (size > 0)
+            std::memcpy(slot->payload, payload, size);
+        // the Server reclaims slots left unpublished for too long, assuming their client died
+        if (!shm::publish(slot, position))
+            return SyntactsError_NotConnected;
+        return SyntactsError_NoError;
+    }
+
+    shm::Mapping m_mapping;
+    shm::Region* m_region;
+    std::string m_buffer;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// CLIENT
+///////////////////////////////////////////////////////////////////////////////
+
+Client::Client() :
+    m_impl(std::make_unique<Client::Impl>())
+{ }
+
+Client::~Client() { }
+
+int Client::connect(const std::string& name) {
+    return m_impl->connect(name);
+}
+
+void Client::disconnect() {
+    m_impl->disconnect();
+}
+
+bool Client::isConnected() const {
+    return m_impl->connected();
+}
+
+int Client::play(int channel, const Signal& signal) {
+    if (!m_impl->connected())
+        return SyntactsError_NotConnected;
+    if (!Library::encodeSignal(signal, m_impl->m_buffer))
+        return SyntactsError_NoWaveform;
+    return m_impl->send(shm::OpPlay, channel, 0, m_impl->m_buffer.data(), m_impl->m_buffer.size());
+}
+
+int Client::playLibrary(int channel, const std::string& name) {
+    return m_impl->send(shm::OpPlayLibrary, channel, 0, name.data(), name.size());
+}
+
+int Client::stop(int channel) {
+    return m_impl->send(shm::OpStop, channel);
+}
+
+int Client::stopAll() {
+    return m_impl->send(shm::OpStopAll, -1);
+}
+
+int Client::pause(int channel) {
+    return m_impl->send(shm::OpPause, channel);
+}
+
+int Client::resume(int channel) {
+    return m_impl->send(shm::OpResume, channel);
+}
+
+int Client::setVolume(int channel, double volume) {
+    return m_impl->send(shm::OpSetVolume, channel, volume);
+}
+
+int Client::setPitch(int channel, double pitch) {
+    return m_impl->send(shm::OpSetPitch, channel, pitch);
+}
+
+int Client::getChannelCount() const {
+    return m_impl->connected() ? m_impl->m_region->channelCount : 0;
+}
+
+double Client::getSampleRate() const {
+    return m_impl->connected() ? m_impl->m_region->sampleRate : 0;
+}
+
+} // namespace tact
@@ -1,28 +1,106 @@
 #include <Tact/Curve.hpp>
 #include <Tact/Util.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 namespace tact
 {
 
+/// Value and slope of each table interval; a NaN slope marks an interval evaluated exactly
+struct Curve::Table {
+    struct Entry {
+        double value, slope;
+    };
+    std::vector<Entry> entries;
+};
+
 Curve::Curve() : Curve(Curves::Linear()) {}
 
 double Curve::operator()(double t) const
 {
+    if (m_table && t >= 0 && t <= 1) {
+        double x = t * TABLE_SIZE;
+        int i = std::min(static_cast<int>(x), TABLE_SIZE - 1);
+        const Table::Entry& e = m_table->entries[i];
+        if (!std::isnan(e.slope))
+            return e.value + e.slope * (x - i);
+    }
     return m_ptr->operator()(t);
 }
 
 double Curve::operator()(double a, double b, double t) const
 {
-    return lerp(a, b, m_ptr->operator()(t));
+    return lerp(a, b, operator()(t));
+}
+
+void Curve::operator()(const double* t, double* y, int n) const
+{
+    if (!m_table) {
+        for (int i = 0; i < n; ++i)
+            y[i] = m_ptr->operator()(t[i]);
+        return;
+    }
+    const Table::Entry* entries = m_table->entries.data();
+    for (int i = 0; i < n; ++i) {
+        double x = t[i] * TABLE_SIZE;
+        if (t[i] >= 0 && t[i] <= 1) {
+            int j = std::min(static_cast<int>(x), TABLE_SIZE - 1);
+            if (!std::isnan(entries[j].slope)) {
+                y[i] = entries[j].value + entries[j].slope * (x - j);
+                continue;
+            }
+        }
+        y[i] = m_ptr->operator()(t[i]);
+    }
 }
 
 const char* Curve::name() const  {
     return m_ptr->name();
 }
 
+Curve Curve::baked() const {
+    Curve curve(*this);
+    if (!curve.m_table)
+        curve.m_table = m_ptr->table();
+    return curve;
+}
+
+Curve Curve::exact() const {
+    Curve curve(*this);
+    curve.m_table = nullptr;
+    return curve;
+}
+
+bool Curve::isBaked() const {
+    return m_table != nullptr;
+}
+
+std::shared_ptr<const Curve::Table> Curve::bake(const Concept& curve) {
+    auto table = std::make_shared<Table>();
+    table->entries.resize(TABLE_SIZE);
+    double y0 = curve(0);
+    for (int i = 0; i < TABLE_SIZE; ++i) {
+        double y1 = curve((double)(i + 1) / TABLE_SIZE);
+        double slope = y1 - y0;
+        // check the interval's interior against the chord and fall back to exact evaluation where it strays
+        for (int k = 1; k < 4; ++k) {
+            double f = 0.25 * k;
+            if (std::abs(curve((i + f) / TABLE_SIZE) - (y0 + slope * f)) > TABLE_TOLERANCE) {
+                slope = std::numeric_limits<double>::quiet_NaN();
+                break;
+            }
+        }
+        table->entries[i] = {y0, slope};
+        y0 = y1;
+    }
+    return table;
+}
+
 namespace Curves
 {
-double Instant::operator()(double t) const
+double Instant::operator()(double) const
 {
     return 1;
 }
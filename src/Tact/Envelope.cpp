@@ -1,6 +1,8 @@
 #include <Tact/Envelope.hpp>
 #include <Tact/Oscillator.hpp>
 #include <functional>
+#include <algorithm>
+#include <iterator>
 
 namespace tact {
 
@@ -17,29 +19,189 @@ double Envelope::length() const {
     return duration;
 }
 
-KeyedEnvelope::KeyedEnvelope(double amplitude0)
+double Envelope::peak() const {
+    return std::abs(amplitude);
+}
+
+bool Envelope::silent(double t0, double) const {
+    return amplitude == 0 || t0 > duration;
+}
+
+namespace {
+
+// forward cursor steps tried before falling back to binary search
+constexpr int CURSOR_STEPS = 4;
+
+} // namespace
+
+KeyedEnvelope::KeyedEnvelope(double amplitude0) : m_count(0), m_length(0), m_cursor(0)
 {
    addKey(0.0f, amplitude0, Curves::Instant());
 }
 
+KeyedEnvelope::KeyedEnvelope(const KeyedEnvelope& other) :
+    m_inline(other.m_inline), m_heap(other.m_heap), m_count(other.m_count), m_length(other.m_length),
+    m_cursor(other.m_cursor.load(std::memory_order_relaxed))
+{
+}
+
+KeyedEnvelope::KeyedEnvelope(KeyedEnvelope&& other) noexcept :
+    m_inline(std::move(other.m_inline)), m_heap(std::move(other.m_heap)), m_count(other.m_count), 
+    m_length(other.m_length), m_cursor(other.m_cursor.load(std::memory_order_relaxed))
+{
+    other.clearKeys();
+}
+
+KeyedEnvelope& KeyedEnvelope::operator=(const KeyedEnvelope& other) {
+    m_inline = other.m_inline;
+    m_heap   = other.m_heap;
+    m_count  = other.m_count;
+    m_length = other.m_length;
+    m_cursor.store(other.m_cursor.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+KeyedEnvelope& KeyedEnvelope::operator=(KeyedEnvelope&& other) noexcept {
+    m_inline = std::move(other.m_inline);
+    m_heap   = std::move(other.m_heap);
+    m_count  = other.m_count;
+    m_length = other.m_length;
+    m_cursor.store(other.m_cursor.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    other.clearKeys();
+    return *this;
+}
+
 void KeyedEnvelope::addKey(double t, double amplitude, Curve curve) {
-    keys[t] = std::make_pair(amplitude, curve);
+    Node* n = nodes();
+    // keys added in order append in O(1); a key at an existing time replaces it
+    int idx = m_count;
+    if (m_count > 0 && n[m_count - 1].key.t >= t)
+        idx = static_cast<int>(std::lower_bound(n, n + m_count, t, [](const Node& a, double t) { return a.key.t < t; }) - n);
+    if (idx < m_count && n[idx].key.t == t) {
+        n[idx].key.amplitude = amplitude;
+        n[idx].key.curve     = std::move(curve);
+    }
+    else {
+        if (m_count == INLINE_KEYS)
+            m_heap.assign(std::make_move_iterator(m_inline.begin()), std::make_move_iterator(m_inline.end()));
+        if (m_count >= INLINE_KEYS)
+            m_heap.emplace_back();
+        m_count++;
+        n = nodes();
+        std::move_backward(n + idx, n + m_count - 1, n + m_count);
+        n[idx].key = Key{t, amplitude, std::move(curve)};
+    }
+    rebuildSegments(idx);
+    m_length = n[m_count - 1].key.t;
+    m_cursor.store(0, std::memory_order_relaxed);
 }
 
-double KeyedEnvelope::sample(double t) const {
-    if (t > length())
+void KeyedEnvelope::clearKeys() {
+    m_heap.clear();
+    m_count  = 0;
+    m_length = 0;
+    m_cursor.store(0, std::memory_order_relaxed);
+}
+
+int KeyedEnvelope::keyCount() const {
+    return m_count;
+}
+
+const KeyedEnvelope::Key& KeyedEnvelope::getKey(int idx) const {
+    return nodes()[idx].key;
+}
+
+std::map<double, std::pair<double, Curve>> KeyedEnvelope::keys() const {
+    std::map<double, std::pair<double, Curve>> keys;
+    for (int i = 0; i < m_count; ++i)
+        keys[nodes()[i].key.t] = std::make_pair(nodes()[i].key.amplitude, nodes()[i].key.curve);
+    return keys;
+}
+
+void KeyedEnvelope::rebuildSegments(int idx) {
+    Node* n = nodes();
+    for (int i = idx; i < std::min(idx + 2, m_count); ++i) {
+        if (i == 0) {
+            n[i].invDuration = 0;
+            n[i].delta       = 0;
+            n[i].linear      = false;
+            continue;
+        }
+        n[i].invDuration = 1.0 / (n[i].key.t - n[i-1].key.t);
+        n[i].delta       = n[i].key.amplitude - n[i-1].key.amplitude;
+        n[i].linear      = n[i].key.curve.isType<Curves::Linear>();
+    }
+}
+
+double KeyedEnvelope::sampleAt(double t, int& cursor) const {
+    if (m_count == 0 || t > m_length)
         return 0.0f;
-    auto b = keys.lower_bound(t);
-    if (b->first == t)
-        return b->second.first;
-    auto a = std::prev(b);
-    t = (t - a->first) / (b->first - a->first);
-    double sample = b->second.second(a->second.first, b->second.first, t);    
+    const Node* n = nodes();
+    if (t <= n[0].key.t)
+        return n[0].key.amplitude;
+    // find the first key at or after t (t is within (first, last], so it exists and is > 0)
+    int i = cursor;
+    if (i < 1 || i >= m_count || n[i-1].key.t >= t) 
+        i = static_cast<int>(std::lower_bound(n + 1, n + m_count, t, [](const Node& a, double t) { return a.key.t < t; }) - n);
+    else {
+        int steps = 0;
+        while (n[i].key.t < t && ++steps < CURSOR_STEPS)
+            ++i;
+        if (n[i].key.t < t)
+            i = static_cast<int>(std::lower_bound(n + i, n + m_count, t, [](const Node& a, double t) { return a.key.t < t; }) - n);
+    }
+    cursor = i;
+    const Node& b = n[i];
+    if (b.key.t == t)
+        return b.key.amplitude;
+    const Key& a = n[i-1].key;
+    double x = (t - a.t) * b.invDuration;
+    return a.amplitude + b.delta * (b.linear ? x : b.key.curve(x));
+}
+
+double KeyedEnvelope::sample(double t) const {
+    int cursor = m_cursor.load(std::memory_order_relaxed);
+    double sample = sampleAt(t, cursor);
+    m_cursor.store(cursor, std::memory_order_relaxed);
     return sample;
 }
 
+void KeyedEnvelope::sample(const double* t, double* b, int n) const {
+    int cursor = m_cursor.load(std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i)
+        b[i] = sampleAt(t[i], cursor);
+    m_cursor.store(cursor, std::memory_order_relaxed);
+}
+
 double KeyedEnvelope::length() const {
-    return keys.rbegin()->first;
+    return m_length;
+}
+
+double KeyedEnvelope::peak() const {
+    const Node* n = nodes();
+    double peak = 0;
+    for (int i = 0; i < m_count; ++i) {
+        peak = std::max(peak, std::abs(n[i].key.amplitude));
+        // curves such as Back and Elastic overshoot their keys, by less than the segment's delta
+        if (i > 0 && !n[i].linear && !n[i].key.curve.isType<Curves::Instant>())
+            peak = std::max(peak, std::max(std::abs(n[i-1].key.amplitude), std::abs(n[i].key.amplitude)) + std::abs(n[i].delta));
+    }
+    return peak;
+}
+
+bool KeyedEnvelope::silent(double t0, double t1) const {
+    if (m_count == 0 || t0 > m_length)
+        return true;
+    const Node* n = nodes();
+    // segments interpolate between their keys, so zero keys on both ends give exact zeros
+    int i = static_cast<int>(std::lower_bound(n, n + m_count, t0, [](const Node& a, double t) { return a.key.t < t; }) - n);
+    for (int k = std::max(i - 1, 0); k < m_count; ++k) {
+        if (n[k].key.amplitude != 0)
+            return false;
+        if (n[k].key.t >= t1)
+            break;
+    }
+    return true;
 }
 
 ASR::ASR(double attackTime, double sustainTime, double releaseTime, double attackAmplitude, Curve attackCurve, Curve releaseCurve)
@@ -68,6 +230,10 @@ double ExponentialDecay::length() const {
     return - std::log(0.001 /amplitude) / decay;
 }
 
+double ExponentialDecay::peak() const {
+    return decay >= 0 ? std::abs(amplitude) : INF;
+}
+
 SignalEnvelope::SignalEnvelope(Signal _signal, double _duration , double _amplitude) :
     signal(_signal), duration(_duration), amplitude(_amplitude)
 { }
@@ -84,4 +250,9 @@ double SignalEnvelope::length() const {
     return duration;
 }
 
+double SignalEnvelope::peak() const {
+    // signal is remapped from [-1,1] to [0,amplitude]
+    return std::abs(amplitude) * (1 + signal.peak()) / 2;
+}
+
 } // namespace tact
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include <misc/exprtk.hpp>
 #include <iostream>
 #include <Tact/Util.hpp>
+#include <algorithm>
+#include <cmath>
+#include <atomic>
+#include <array>
 
 namespace tact
 {
@@ -18,19 +22,70 @@ double Scalar::length() const
     return INF;
 }
 
+double Scalar::peak() const
+{
+    return std::abs(value);
+}
+
+bool Scalar::silent(double, double) const
+{
+    return value == 0;
+}
+
 Ramp::Ramp(double _initial, double _rate) : initial(_initial), rate(_rate), duration(INF) {}
 Ramp::Ramp(double _initial, double _final, double _duration) : initial(_initial), rate((_final - _initial) / _duration), duration(_duration) {}
 double Ramp::sample(double t) const { return initial + rate * t; }
 double Ramp::length() const { return duration; }
+double Ramp::peak() const { return rate == 0 ? std::abs(initial) : std::max(std::abs(initial), std::abs(initial + rate * duration)); }
+
+namespace {
+
+constexpr std::uint64_t GOLDEN = 0x9E3779B97F4A7C15ull; // counter increment (SplitMix64)
+constexpr std::uint64_t STREAM = 0xD1B54A32D192ED03ull; // offset between independent streams
+
+// colored noise is scaled to this standard deviation and clipped to [-1,1]
+constexpr double COLORED_STD = 0.25;
+
+/// SplitMix64 finalizer
+inline std::uint64_t mix(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/// Uniform value in [-1,1) for counter in stream key
+inline double uniform(std::uint64_t key, std::int64_t counter) {
+    return (mix(key + static_cast<std::uint64_t>(counter) * GOLDEN) >> 11) * 0x1.0p-52 - 1.0;
+}
+
+inline std::int64_t noiseCounter(double t) {
+    return static_cast<std::int64_t>(std::floor(t * NOISE_RATE));
+}
 
-Noise::Noise()
+/// Seeds default constructed noise so separately created generators are uncorrelated
+std::uint64_t nextSeed() {
+    static std::atomic<std::uint64_t> s_next(0);
+    return mix((s_next.fetch_add(1, std::memory_order_relaxed) + 1) * GOLDEN);
+}
+
+} // namespace
+
+Noise::Noise() : seed(nextSeed())
+{ }
+
+Noise::Noise(std::uint64_t _seed) : seed(_seed)
 { }
 
 double Noise::sample(double t) const
 {
-    static std::uniform_real_distribution<double> dist(-1,1);
-    static std::mt19937 rgen;
-    return dist(rgen);
+    return uniform(mix(seed), noiseCounter(t));
+}
+
+void Noise::sample(const double* t, double* b, int n) const
+{
+    const std::uint64_t key = mix(seed);
+    for (int i = 0; i < n; ++i)
+        b[i] = uniform(key, noiseCounter(t[i]));
 }
 
 double Noise::length() const
@@ -38,29 +93,324 @@ double Noise::length() const
     return INF;
 }
 
+double Noise::peak() const
+{
+    return 1;
+}
+
+PinkNoise::PinkNoise() : seed(nextSeed())
+{ }
+
+PinkNoise::PinkNoise(std::uint64_t _seed) : seed(_seed)
+{ }
+
+double PinkNoise::value(std::int64_t n, Rows& rows) const
+{
+    static const double scale = COLORED_STD / std::sqrt(OCTAVES / 3.0);
+    // octave k holds a new value every 2^k counters, so only octaves below the highest changed bit move
+    const std::uint64_t key  = mix(seed);
+    const std::uint64_t diff = rows.counter == INT64_MIN ? ~std::uint64_t(0) : static_cast<std::uint64_t>(n ^ rows.counter);
+    for (int k = 0; k < OCTAVES && (diff >> k) != 0; ++k)
+        rows.value[k] = uniform(key + k * STREAM, n >> k);
+    rows.counter = n;
+    double sum = 0;
+    for (int k = 0; k < OCTAVES; ++k)
+        sum += rows.value[k];
+    return clamp(sum * scale, -1, 1);
+}
+
+double PinkNoise::sample(double t) const
+{
+    Rows rows;
+    return value(noiseCounter(t), rows);
+}
+
+void PinkNoise::sample(const double* t, double* b, int n) const
+{
+    Rows rows;
+    for (int i = 0; i < n; ++i)
+        b[i] = value(noiseCounter(t[i]), rows);
+}
+
+double PinkNoise::length() const
+{
+    return INF;
+}
+
+double PinkNoise::peak() const
+{
+    return 1;
+}
+
+BrownNoise::BrownNoise() : seed(nextSeed())
+{ }
+
+BrownNoise::BrownNoise(std::uint64_t _seed) : seed(_seed)
+{ }
+
+double BrownNoise::value(double x, Rows& rows) const
+{
+    // octave k has weight 2^((k - FIRST)/2) and variance 2/9 when linearly interpolated
+    static const double scale = COLORED_STD / std::sqrt(2.0 / 9.0 * ((1 << OCTAVES) - 1));
+    std::int64_t n = static_cast<std::int64_t>(std::floor(x));
+    // only octaves below the highest changed bit of the counter move to a new segment
+    const std::uint64_t diff = rows.valid ? static_cast<std::uint64_t>(n ^ rows.last) : ~std::uint64_t(0);
+    if (diff >> FIRST != 0) {
+        const std::uint64_t key = mix(seed);
+        for (int j = 0; j < OCTAVES && (diff >> (FIRST + j)) != 0; ++j) {
+            const int k = FIRST + j;
+            std::int64_t c = n >> k;
+            std::uint64_t stream = key + k * STREAM;
+            // consecutive segments share an endpoint
+            rows.a[j] = rows.valid && c == rows.counter[j] + 1 ? rows.b[j] : uniform(stream, c);
+            rows.b[j] = uniform(stream, c + 1);
+            rows.counter[j] = c;
+        }
+    }
+    rows.last  = n;
+    rows.valid = true;
+    double sum = 0, w = 1;
+    for (int j = 0; j < OCTAVES; ++j, w *= SQRT2) {
+        const std::int64_t span = std::int64_t(1) << (FIRST + j);
+        double f = (x - static_cast<double>(rows.counter[j] * span)) * (1.0 / span);
+        sum += w * (rows.a[j] + (rows.b[j] - rows.a[j]) * f);
+    }
+    return clamp(sum * scale, -1, 1);
+}
+
+double BrownNoise::sample(double t) const
+{
+    Rows rows;
+    return value(t * NOISE_RATE, rows);
+}
+
+void BrownNoise::sample(const double* t, double* b, int n) const
+{
+    Rows rows;
+    for (int i = 0; i < n; ++i)
+        b[i] = value(t[i] * NOISE_RATE, rows);
+}
+
+double BrownNoise::length() const
+{
+    return INF;
+}
+
+double BrownNoise::peak() const
+{
+    return 1;
+}
+
+BandNoise::BandNoise() : BandNoise(100, 300)
+{ }
+
+BandNoise::BandNoise(double _low, double _high, std::uint64_t _seed) : low(_low), high(_high), seed(_seed)
+{ }
+
+BandNoise::BandNoise(double _low, double _high) : BandNoise(_low, _high, nextSeed())
+{ }
+
+double BandNoise::advance(std::int64_t n) const {
+    if (low != m_low || high != m_high) {
+        // 2nd order Butterworth highpass at low and lowpass at high (RBJ cookbook)
+        double lo = clamp(low, 0.1, 0.45 * NOISE_RATE);
+        double hi = clamp(high, lo, 0.45 * NOISE_RATE);
+        auto design = [](Biquad& f, double fc, bool highpass) {
+            double w0 = TWO_PI * fc / NOISE_RATE;
+            double cw = std::cos(w0), alpha = std::sin(w0) / SQRT2;
+            double a0 = 1 + alpha;
+            f.b0 = (highpass ? (1 + cw) : (1 - cw)) / 2 / a0;
+            f.b1 = (highpass ? -(1 + cw) : (1 - cw)) / a0;
+            f.b2 = f.b0;
+            f.a1 = -2 * cw / a0;
+            f.a2 = (1 - alpha) / a0;
+        };
+        design(m_highpass, lo, true);
+        design(m_lowpass, hi, false);
+        m_gain    = COLORED_STD / std::sqrt(2.0 / 3.0 * std::max(hi - lo, 1.0) / NOISE_RATE);
+        m_low     = low;
+        m_high    = high;
+        m_counter = -1;
+    }
+    if (n < 0)
+        return 0;
+    if (n == m_counter)
+        return m_last;
+    // seeking backward (or far forward) restarts the filters before n, long enough for the highpass 
+    // (decaying at 2 pi low / sqrt 2) to settle to 1e-4 but bounded so seeks stay cheap at low cutoffs
+    const std::int64_t warmup = static_cast<std::int64_t>(std::min(2.1 / std::max(m_low, 0.1), 0.1) * NOISE_RATE);
+    if (m_counter < 0 || n < m_counter || n - m_counter > warmup) {
+        for (auto f : {&m_highpass, &m_lowpass})
+            f->x1 = f->x2 = f->y1 = f->y2 = 0;
+        m_counter = std::max<std::int64_t>(n - warmup, 0) - 1;
+    }
+    const std::uint64_t key = mix(seed);
+    auto step = [](Biquad& f, double x) {
+        double y = f.b0 * x + f.b1 * f.x1 + f.b2 * f.x2 - f.a1 * f.y1 - f.a2 * f.y2;
+        f.x2 = f.x1; f.x1 = x;
+        f.y2 = f.y1; f.y1 = y;
+        return y;
+    };
+    double y = 0;
+    while (m_counter < n) {
+        ++m_counter;
+        y = step(m_lowpass, step(m_highpass, uniform(key, m_counter)));
+    }
+    m_last = clamp(y * m_gain, -1, 1);
+    return m_last;
+}
+
+double BandNoise::sample(double t) const
+{
+    return advance(noiseCounter(t));
+}
+
+void BandNoise::sample(const double* t, double* b, int n) const
+{
+    for (int i = 0; i < n; ++i)
+        b[i] = advance(noiseCounter(t[i]));
+}
+
+double BandNoise::length() const
+{
+    return INF;
+}
+
+double BandNoise::peak() const
+{
+    return 1;
+}
+
+namespace {
+
+constexpr int EXPRESSION_EVALUATORS = 4; // evaluations of one Expression that may run at once without waiting
+
+} // namespace
+
 class Expression::Impl
 {
 public:
-    Impl() : m_t(0) {}
+    /// A compiled copy of the expression with its own time variable, used by one evaluation at a time
+    struct Evaluator {
+        exprtk::symbol_table<double> table;
+        exprtk::expression<double> expr;
+        double t = 0;
+        bool ok = false;
+        std::atomic<bool> busy{false};
+    };
+
+    /// Claims a free evaluator from the fixed pool without locking or allocating (spins only if all are busy)
+    Evaluator* acquire() const
+    {
+        for (;;) {
+            for (auto& e : m_evaluators) {
+                if (!e->busy.load(std::memory_order_relaxed) && !e->busy.exchange(true, std::memory_order_acquire))
+                    return e.get();
+            }
+        }
+    }
+
+    void release(Evaluator* e) const
+    {
+        e->busy.store(false, std::memory_order_release);
+    }
 
     double sample(double t) const
     {
-        m_t = t;
-        return m_expr.value();
+        Evaluator* e = acquire();
+        double y = 0;
+        if (e->ok) {
+            e->t = t;
+            y = e->expr.value();
+        }
+        release(e);
+        return y;
+    }
+
+    void sample(const double* t, double* b, int n) const
+    {
+        Evaluator* e = acquire();
+        if (e->ok) {
+            for (int i = 0; i < n; ++i) {
+                e->t = t[i];
+                b[i] = e->expr.value();
+            }
+        }
+        else {
+            std::fill(b, b + n, 0.0);
+        }
+        release(e);
     }
+
     bool setExpression(const std::string &expr)
     {
         m_str = expr;
-        m_table.add_variable("t", m_t);
-        m_table.add_pi();
-        m_expr.register_symbol_table(m_table);
-        return m_parser.compile(m_str, m_expr);
+        return rebuild();
     }
-    exprtk::symbol_table<double> m_table;
-    exprtk::expression<double> m_expr;
-    exprtk::parser<double> m_parser;
+
+    bool setVariable(const std::string& name, double value)
+    {
+        auto it = m_vars.find(name);
+        if (it != m_vars.end()) {
+            // evaluators are bound to the value by reference, so no recompile is needed
+            it->second = value;
+            return m_ok;
+        }
+        if (!validName(name))
+            return false;
+        m_vars[name] = value;
+        return rebuild();
+    }
+
+    bool set(const std::string& expr, const std::map<std::string, double>& vars)
+    {
+        m_vars.clear();
+        for (auto& v : vars) {
+            if (validName(v.first))
+                m_vars[v.first] = v.second;
+        }
+        m_str = expr;
+        return rebuild();
+    }
+
+    /// Returns true if name can be bound alongside t and pi
+    static bool validName(const std::string& name)
+    {
+        exprtk::symbol_table<double> probe;
+        double t = 0, v = 0;
+        probe.add_variable("t", t);
+        probe.add_pi();
+        return probe.add_variable(name, v);
+    }
+
+    /// Compiles every evaluator of the pool up front, so sampling never compiles (not safe while sampling, like any parameter change)
+    bool rebuild()
+    {
+        for (auto& e : m_evaluators) {
+            e = std::make_unique<Evaluator>();
+            compile(*e);
+        }
+        m_ok = m_evaluators[0]->ok;
+        return m_ok;
+    }
+
+    void compile(Evaluator& e)
+    {
+        e.table.add_variable("t", e.t);
+        e.table.add_pi();
+        // variables are shared by reference (std::map nodes never move)
+        for (auto& v : m_vars)
+            e.table.add_variable(v.first, v.second);
+        e.expr.register_symbol_table(e.table);
+        // the parser's default settings fold constant subexpressions at compile time
+        e.ok = m_parser.compile(m_str, e.expr);
+    }
+
     std::string m_str;
-    mutable double m_t;
+    std::map<std::string, double> m_vars; ///< bound by reference into every evaluator
+    bool m_ok = false;
+    exprtk::parser<double> m_parser;
+    std::array<std::unique_ptr<Evaluator>, EXPRESSION_EVALUATORS> m_evaluators;
 };
 
 Expression::Expression(const std::string &expr) : m_impl(std::move(std::make_unique<Expression::Impl>()))
@@ -73,14 +423,21 @@ Expression::~Expression() {
 }
 
 Expression::Expression(const Expression& other) :
-    Expression(other.getExpression())
-{ }
+    m_impl(std::make_unique<Expression::Impl>())
+{ 
+    set(other.getExpression(), other.getVariables());
+}
 
 double Expression::sample(double t) const
 {
     return m_impl->sample(t);
 }
 
+void Expression::sample(const double* t, double* b, int n) const
+{
+    m_impl->sample(t, b, n);
+}
+
 double Expression::length() const
 {
     return INF;
@@ -100,19 +457,122 @@ bool Expression::operator=(const std::string &expr)
     return setExpression(expr);
 }
 
-double PolyBezier::sample(double t) const {
-    if (solution.size() < 2)
-        return 0; 
+bool Expression::setVariable(const std::string& name, double value)
+{
+    return m_impl->setVariable(name, value);
+}
+
+double Expression::getVariable(const std::string& name) const
+{
+    auto it = m_impl->m_vars.find(name);
+    return it != m_impl->m_vars.end() ? it->second : 0;
+}
+
+const std::map<std::string, double>& Expression::getVariables() const
+{
+    return m_impl->m_vars;
+}
+
+bool Expression::set(const std::string& expr, const std::map<std::string, double>& vars)
+{
+    return m_impl->set(expr, vars);
+}
+
+namespace {
+
+constexpr int BEZIER_DEPTH  = 10; // maximum subdivisions of one curve (at most 1024 segments)
+constexpr int CURSOR_STEPS  = 4;  // segments the cursor steps forward before falling back to a binary search
+
+/// Appends the end points of line segments approximating cubic Bezier c to out (which already holds c[0])
+void flatten(const PolyBezier::Point* c, double tolerance, int depth, std::vector<PolyBezier::Point>& out) {
+    double dt = c[3].t - c[0].t;
+    // control points within the chord's time span bound the curve's vertical distance from it
+    bool flat = c[1].t >= c[0].t && c[1].t <= c[3].t && c[2].t >= c[0].t && c[2].t <= c[3].t;
+    if (flat && dt > 0) {
+        double s  = (c[3].y - c[0].y) / dt;
+        double d1 = c[1].y - c[0].y - s * (c[1].t - c[0].t);
+        double d2 = c[2].y - c[0].y - s * (c[2].t - c[0].t);
+        flat = std::max(std::abs(d1), std::abs(d2)) <= tolerance;
+    }
+    if (flat || depth >= BEZIER_DEPTH) {
+        // keep time non-decreasing so the solution can be searched
+        out.push_back({std::max(c[3].t, out.back().t), c[3].y});
+        return;
+    }
+    // de Casteljau split at the midpoint
+    auto mid = [](const PolyBezier::Point& a, const PolyBezier::Point& b) { return PolyBezier::Point{(a.t + b.t) * 0.5, (a.y + b.y) * 0.5}; };
+    PolyBezier::Point p01 = mid(c[0], c[1]), p12 = mid(c[1], c[2]), p23 = mid(c[2], c[3]);
+    PolyBezier::Point p012 = mid(p01, p12), p123 = mid(p12, p23);
+    PolyBezier::Point m = mid(p012, p123);
+    PolyBezier::Point l[4] = {c[0], p01, p012, m};
+    PolyBezier::Point r[4] = {m, p123, p23, c[3]};
+    flatten(l, tolerance, depth + 1, out);
+    flatten(r, tolerance, depth + 1, out);
+}
+
+} // namespace
+
+PolyBezier::PolyBezier(const PolyBezier& other) :
+    points(other.points), solution(other.solution), m_slopes(other.m_slopes),
+    m_cursor(other.m_cursor.load(std::memory_order_relaxed))
+{
+}
+
+PolyBezier::PolyBezier(PolyBezier&& other) noexcept :
+    points(std::move(other.points)), solution(std::move(other.solution)), m_slopes(std::move(other.m_slopes)),
+    m_cursor(other.m_cursor.load(std::memory_order_relaxed))
+{
+}
+
+PolyBezier& PolyBezier::operator=(const PolyBezier& other) {
+    points   = other.points;
+    solution = other.solution;
+    m_slopes = other.m_slopes;
+    m_cursor.store(other.m_cursor.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+PolyBezier& PolyBezier::operator=(PolyBezier&& other) noexcept {
+    points   = std::move(other.points);
+    solution = std::move(other.solution);
+    m_slopes = std::move(other.m_slopes);
+    m_cursor.store(other.m_cursor.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+double PolyBezier::sampleAt(double t, int& cursor) const {
+    const int count = static_cast<int>(solution.size());
+    if (count < 2 || m_slopes.size() != solution.size() || t < solution[0].t || t >= solution[count-1].t)
+        return 0;
+    const Point* s = solution.data();
+    auto after = [](double t, const Point& p) { return t < p.t; };
+    // find the first point after t (t is within [first, last), so it exists and is > 0)
+    int i = cursor;
+    if (i < 1 || i >= count || s[i-1].t > t)
+        i = static_cast<int>(std::upper_bound(s + 1, s + count, t, after) - s);
     else {
-        auto it = std::find_if(solution.begin(), solution.end(), [&](const Point& p){return p.t > t; } );
-        if (it == solution.begin() || it == solution.end())
-            return 0; 
-        else {
-            const Point& p0 = *(std::prev(it));
-            const Point& p1 = *it;   
-            return remap(t, p0.t, p1.t, p0.y, p1.y);         
-        }
+        int steps = 0;
+        while (s[i].t <= t && ++steps < CURSOR_STEPS)
+            ++i;
+        if (s[i].t <= t)
+            i = static_cast<int>(std::upper_bound(s + i, s + count, t, after) - s);
     }
+    cursor = i;
+    return s[i-1].y + m_slopes[i] * (t - s[i-1].t);
+}
+
+double PolyBezier::sample(double t) const {
+    int cursor = m_cursor.load(std::memory_order_relaxed);
+    double sample = sampleAt(t, cursor);
+    m_cursor.store(cursor, std::memory_order_relaxed);
+    return sample;
+}
+
+void PolyBezier::sample(const double* t, double* b, int n) const {
+    int cursor = m_cursor.load(std::memory_order_relaxed);
+    for (int i = 0; i < n; ++i)
+        b[i] = sampleAt(t[i], cursor);
+    m_cursor.store(cursor, std::memory_order_relaxed);
 }
 
 double PolyBezier::length() const {
@@ -121,53 +581,192 @@ double PolyBezier::length() const {
     return 0;
 }
 
-void PolyBezier::solve() {
-    constexpr int segments = 16;
+void PolyBezier::solve(double tolerance) {
     solution.clear();
+    m_slopes.clear();
     if (points.size() > 1) {
-        std::size_t beziers = points.size() - 1;
-        solution.reserve(segments * beziers);
-        for (int b = 0; b < beziers; ++b) {
-            for (int i = 0; i < segments; ++i) {
-                auto& l = points[b];
-                auto& r = points[b+1];
-                double t = (double)i / (double)(segments-1);
-                double u = 1.0f - t;
-                double w1 = u*u*u;
-                double w2 = 3*u*u*t;
-                double w3 = 3*u*t*t;
-                double w4 = t*t*t;
-                double x = w1*l.p.t + w2*l.cpR.t + w3*r.cpL.t + w4*r.p.t;
-                double y = w1*l.p.y + w2*l.cpR.y + w3*r.cpL.y + w4*r.p.y;
-                solution.push_back({x,y});
-            }
+        solution.push_back(points[0].p);
+        for (std::size_t b = 0; b + 1 < points.size(); ++b) {
+            auto& l = points[b];
+            auto& r = points[b+1];
+            Point c[4] = {l.p, l.cpR, r.cpL, r.p};
+            flatten(c, tolerance, 0, solution);
+        }
+        m_slopes.resize(solution.size(), 0);
+        for (std::size_t i = 1; i < solution.size(); ++i) {
+            double dt = solution[i].t - solution[i-1].t;
+            m_slopes[i] = dt > 0 ? (solution[i].y - solution[i-1].y) / dt : 0;
         }
     }
+    m_cursor.store(0, std::memory_order_relaxed);
 }
 
 // https://math.stackexchange.com/questions/26846/is-there-an-explicit-form-for-cubic-b%c3%a9zier-curves/348645#348645
 
 
-Samples::Samples() : m_sampleRate(44100), m_samples() { }
+namespace {
+
+// windowed sinc used for playback interpolation
+constexpr int SINC_HALF   = 8;
+constexpr int SINC_TAPS   = 2 * SINC_HALF;
+constexpr int SINC_PHASES = 256;
+
+// windowed sinc used for offline resampling
+constexpr int RESAMPLE_ZEROS = 32;  // zero crossings per side
+constexpr int RESAMPLE_RES   = 512; // table entries per zero crossing
+
+inline double sinc(double x) {
+    return x == 0 ? 1.0 : std::sin(PI * x) / (PI * x);
+}
+
+/// Blackman window over [-half, half]
+inline double blackman(double x, double half) {
+    double p = PI * x / half;
+    return 0.42 + 0.5 * std::cos(p) + 0.08 * std::cos(2 * p);
+}
+
+/// Normalized playback kernel, one row of taps per fractional phase in [0,1]
+struct SincTable {
+    SincTable() {
+        for (int p = 0; p <= SINC_PHASES; ++p) {
+            double f = static_cast<double>(p) / SINC_PHASES;
+            double sum = 0;
+            for (int k = 0; k < SINC_TAPS; ++k) {
+                double d = k - (SINC_HALF - 1) - f;
+                taps[p][k] = static_cast<float>(sinc(d) * blackman(d, SINC_HALF));
+                sum += taps[p][k];
+            }
+            for (int k = 0; k < SINC_TAPS; ++k)
+                taps[p][k] = static_cast<float>(taps[p][k] / sum);
+        }
+    }
+    alignas(64) float taps[SINC_PHASES + 1][SINC_TAPS];
+};
+
+const SincTable& sincTable() {
+    static SincTable table;
+    return table;
+}
+
+/// Half of the symmetric resampling kernel, tabulated from 0 to RESAMPLE_ZEROS
+const std::vector<double>& resampleTable() {
+    static std::vector<double> table = [] {
+        std::vector<double> t(RESAMPLE_ZEROS * RESAMPLE_RES + 2, 0.0);
+        for (int i = 0; i <= RESAMPLE_ZEROS * RESAMPLE_RES; ++i) {
+            double x = static_cast<double>(i) / RESAMPLE_RES;
+            t[i] = sinc(x) * blackman(x, RESAMPLE_ZEROS);
+        }
+        return t;
+    }();
+    return table;
+}
+
+/// Reads sample i, treating everything outside of [0,n) as silence
+inline float at(const float* d, std::ptrdiff_t n, std::ptrdiff_t i) {
+    return i >= 0 && i < n ? d[i] : 0.0f;
+}
+
+/// Evaluates samples d[0,n) at fractional index x
+template <Samples::Interpolation I>
+inline double interpolate(const float* d, std::ptrdiff_t n, double x) {
+    if (!(x >= 0) || x >= n)
+        return 0;
+    std::ptrdiff_t i = static_cast<std::ptrdiff_t>(x);
+    if constexpr (I == Samples::Interpolation::Nearest) {
+        return d[i];
+    }
+    else if constexpr (I == Samples::Interpolation::Linear) {
+        double f = x - i;
+        double a = d[i];
+        return a + (at(d, n, i + 1) - a) * f;
+    }
+    else if constexpr (I == Samples::Interpolation::Cubic) {
+        double f  = x - i;
+        double p0 = at(d, n, i - 1), p1 = d[i], p2 = at(d, n, i + 1), p3 = at(d, n, i + 2);
+        return p1 + 0.5 * f * (p2 - p0 + f * (2 * p0 - 5 * p1 + 4 * p2 - p3 + f * (3 * (p1 - p2) + p3 - p0)));
+    }
+    else {
+        // blend the two nearest kernel phases
+        double pf = (x - i) * SINC_PHASES;
+        int p = static_cast<int>(pf);
+        float w = static_cast<float>(pf - p);
+        const float* h0 = sincTable().taps[p];
+        const float* h1 = sincTable().taps[p + 1];
+        std::ptrdiff_t base = i - (SINC_HALF - 1);
+        float sum = 0;
+        if (base >= 0 && base + SINC_TAPS <= n) {
+            const float* s = d + base;
+            for (int k = 0; k < SINC_TAPS; ++k) // fixed trip count, vectorized by the compiler
+                sum += s[k] * (h0[k] + w * (h1[k] - h0[k]));
+        }
+        else {
+            for (int k = 0; k < SINC_TAPS; ++k)
+                sum += at(d, n, base + k) * (h0[k] + w * (h1[k] - h0[k]));
+        }
+        return sum;
+    }
+}
+
+template <Samples::Interpolation I>
+inline void interpolate(const float* d, std::ptrdiff_t n, double rate, const double* t, double* b, int count) {
+    for (int j = 0; j < count; ++j)
+        b[j] = interpolate<I>(d, n, t[j] * rate);
+}
+
+} // namespace
+
+Samples::Samples() : 
+    m_sampleRate(44100), m_samples(), m_data(nullptr), m_count(0), m_interpolation(Interpolation::Nearest) 
+{ }
 
 Samples::Samples(const std::vector<float>& samples, double sampleRate) :
+    Samples(std::vector<float>(samples), sampleRate)
+{ }
+
+Samples::Samples(std::vector<float>&& samples, double sampleRate) :
+    m_sampleRate(sampleRate),
     m_samples(std::make_shared<std::vector<float>>(std::move(samples))),
-    m_sampleRate(sampleRate)
+    m_data(m_samples->data()),
+    m_count(m_samples->size()),
+    m_interpolation(Interpolation::Nearest)
+{ }
+
+Samples::Samples(std::shared_ptr<const void> owner, const float* data, std::size_t count, double sampleRate) :
+    m_sampleRate(sampleRate),
+    m_samples(),
+    m_owner(std::move(owner)),
+    m_data(data),
+    m_count(count),
+    m_interpolation(Interpolation::Nearest)
 { }
 
 double Samples::sample(double t) const {
-    std::size_t i = static_cast<std::size_t>(t * m_sampleRate);
-    if (i < m_samples->size() - 1) 
-        return m_samples->operator[](i);
-    return 0;
+    const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(m_count);
+    const double x = t * m_sampleRate;
+    switch (m_interpolation) {
+        case Interpolation::Nearest: return interpolate<Interpolation::Nearest>(m_data, n, x);
+        case Interpolation::Cubic:   return interpolate<Interpolation::Cubic>(m_data, n, x);
+        case Interpolation::Sinc:    return interpolate<Interpolation::Sinc>(m_data, n, x);
+        default:                     return interpolate<Interpolation::Linear>(m_data, n, x);
+    }
+}
+
+void Samples::sample(const double* t, double* b, int count) const {
+    const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(m_count);
+    switch (m_interpolation) {
+        case Interpolation::Nearest: interpolate<Interpolation::Nearest>(m_data, n, m_sampleRate, t, b, count); break;
+        case Interpolation::Cubic:   interpolate<Interpolation::Cubic>(m_data, n, m_sampleRate, t, b, count);   break;
+        case Interpolation::Sinc:    interpolate<Interpolation::Sinc>(m_data, n, m_sampleRate, t, b, count);    break;
+        default:                     interpolate<Interpolation::Linear>(m_data, n, m_sampleRate, t, b, count);  break;
+    }
 }
 
 double Samples::length() const {
-    return static_cast<double>(m_samples->size()) / m_sampleRate;
+    return static_cast<double>(m_count) / m_sampleRate;
 }
 
 int Samples::sampleCount() const {
-    return static_cast<int>(m_samples->size());
+    return static_cast<int>(m_count);
 }
 
 double Samples::sampleRate() const {
@@ -175,7 +774,44 @@ double Samples::sampleRate() const {
 }
 
 double Samples::getSample(int i) const {
-    return m_samples->operator[](i);
+    return m_data[i];
+}
+
+void Samples::setInterpolation(Interpolation interpolation) {
+    if (interpolation == Interpolation::Sinc)
+        sincTable(); // build the kernel here rather than on the audio thread
+    m_interpolation = interpolation;
+}
+
+Samples::Interpolation Samples::getInterpolation() const {
+    return m_interpolation;
+}
+
+Samples Samples::resample(double sampleRate) const {
+    if (sampleRate <= 0 || sampleRate == m_sampleRate || m_count == 0)
+        return *this;
+    const auto& table = resampleTable();
+    const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(m_count);
+    const double step   = m_sampleRate / sampleRate;      // input samples per output sample
+    const double cutoff = std::min(1.0, sampleRate / m_sampleRate); // lowpass below the lower Nyquist
+    const double half   = RESAMPLE_ZEROS / cutoff;        // kernel half width in input samples
+    std::vector<float> out(static_cast<std::size_t>(std::ceil(m_count / step)));
+    for (std::size_t j = 0; j < out.size(); ++j) {
+        double x = j * step;
+        std::ptrdiff_t lo = static_cast<std::ptrdiff_t>(std::ceil(x - half));
+        std::ptrdiff_t hi = static_cast<std::ptrdiff_t>(std::floor(x + half));
+        double sum = 0;
+        for (std::ptrdiff_t k = std::max<std::ptrdiff_t>(lo, 0); k <= std::min(hi, n - 1); ++k) {
+            double u = std::abs(k - x) * cutoff * RESAMPLE_RES;
+            std::size_t i = static_cast<std::size_t>(u);
+            double w = table[i] + (table[i + 1] - table[i]) * (u - i);
+            sum += m_data[k] * w;
+        }
+        out[j] = static_cast<float>(sum * cutoff);
+    }
+    Samples resampled(std::move(out), sampleRate);
+    resampled.m_interpolation = m_interpolation;
+    return resampled;
 }
 
 } // namespace tact
@@ -9,8 +9,11 @@
 #include <Tact/Envelope.hpp>
 #include <Tact/Operator.hpp>
 #include <Tact/Process.hpp>
+#include "Tact/MappedFile.hpp"
 
 #include <fstream>
+#include <sstream>
+#include <streambuf>
 #include <filesystem>
 #include <iostream>
 #include <cstdlib>
@@ -29,25 +32,69 @@
 
 namespace fs = std::filesystem;
 
+namespace tact {
+
+/// Noise saved before it had a seed (its archive is empty and unversioned). Loading converts it
+/// to Noise with the seed drawn on construction, so saving it again writes the current layout.
+struct LegacyNoise : public Noise {
+    Signal runtime() const { return static_cast<const Noise&>(*this); }
+    // save and load hide Noise's versioned functions
+    template <class Archive> 
+    void save(Archive&) const {}
+    template <class Archive> 
+    void load(Archive&) {}
+};
+
+/// Expression saved before it had variables (its archive holds only the unversioned expression
+/// string). Loading converts it to Expression, so saving it again writes the current layout.
+struct LegacyExpression : public Expression {
+    Signal runtime() const { return static_cast<const Expression&>(*this); }
+    template <class Archive>
+    void save(Archive& archive) const {
+        std::string expr = getExpression();
+        archive(TACT_MEMBER(expr));
+    }
+    template <class Archive>
+    void load(Archive& archive) {
+        std::string expr;
+        archive(TACT_MEMBER(expr));
+        setExpression(expr);
+    }
+};
+
+} // namespace tact
+
 // Register Types (must be done in global namespace)
 
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Scalar>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Time>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Ramp>);
-CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Noise>);
-CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Expression>);
+// Noise and Expression gained fields, so they are registered under new names and their old names load the Legacy types
+CEREAL_REGISTER_TYPE_WITH_NAME(tact::Signal::Model<tact::Noise>, "tact::Signal::Model<tact::Noise>[seed]");
+CEREAL_REGISTER_TYPE_WITH_NAME(tact::Signal::Model<tact::LegacyNoise>, "tact::Signal::Model<tact::Noise>");
+CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::PinkNoise>);
+CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::BrownNoise>);
+CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::BandNoise>);
+CEREAL_REGISTER_TYPE_WITH_NAME(tact::Signal::Model<tact::Expression>, "tact::Signal::Model<tact::Expression>[vars]");
+CEREAL_REGISTER_TYPE_WITH_NAME(tact::Signal::Model<tact::LegacyExpression>, "tact::Signal::Model<tact::Expression>");
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::PolyBezier>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Samples>);
 
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Sum>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Product>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Sequence>);
+CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::SequenceRef>);
 
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Sine>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Square>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Saw>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Triangle>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Pwm>);
+CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::ChirpPhase>);
+CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::FmPhase>);
+CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Chirp>);
+CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::FmSine>);
+CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Wavetable>);
 
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Envelope>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::KeyedEnvelope>);
@@ -59,6 +106,7 @@ CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::SignalEnvelope>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Repeater>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Stretcher>);
 CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::Reverser>);
+CEREAL_REGISTER_TYPE(tact::Signal::Model<tact::ControlRate>);
 
 CEREAL_REGISTER_TYPE(tact::Curve::Model<tact::Curves::Instant>);
 CEREAL_REGISTER_TYPE(tact::Curve::Model<tact::Curves::Delayed>);
@@ -118,7 +166,9 @@ FileFormat getFormatFromExt(std::string ext)
         {".aifc", FileFormat::AIFF},
         {".csv", FileFormat::CSV},
         {".txt", FileFormat::CSV},
-        {".json", FileFormat::JSON}};
+        {".json", FileFormat::JSON},
+        {".raw", FileFormat::RAW},
+        {".pcm", FileFormat::RAW}};
     std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
     if (extensions.count(ext))
         return extensions[ext];
@@ -137,6 +187,8 @@ std::string getExtFromFormat(FileFormat format) {
         return ".csv";
     else if (format == FileFormat::JSON)
         return ".json";
+    else if (format == FileFormat::RAW)
+        return ".raw";
     return "";
 }
 
@@ -151,6 +203,14 @@ bool ensureDirectoryExists(fs::path path) {
     return true;
 }
 
+/// Read-only stream buffer over existing memory (avoids copying encoded Signals)
+struct MemoryBuffer : public std::streambuf {
+    MemoryBuffer(const char* data, std::size_t size) {
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
 } // namespace
 
 const std::string &getLibraryDirectory()
@@ -231,6 +291,50 @@ bool loadSignal(Signal &signal, const std::string &name)
     return loadSignalEx(signal, getLibraryDirectory(), name);
 }
 
+bool encodeSignal(const Signal& signal, std::string& buffer) {
+    try
+    {
+        std::ostringstream stream(std::ios::binary);
+        {
+            cereal::BinaryOutputArchive archive(stream);
+            archive(signal);
+        }
+        buffer = stream.str();
+        return true;
+    }
+    catch (cereal::Exception e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+    catch (...)
+    {
+        std::cout << "Unhandled Exception!" << std::endl;
+        return false;
+    }
+}
+
+bool decodeSignal(Signal& signal, const char* data, std::size_t size) {
+    try
+    {
+        MemoryBuffer memory(data, size);
+        std::istream stream(&memory);
+        cereal::BinaryInputArchive archive(stream);
+        archive(signal);
+        return true;
+    }
+    catch (cereal::Exception e)
+    {
+        std::cout << e.what() << std::endl;
+        return false;
+    }
+    catch (...)
+    {
+        std::cout << "Unhandled Exception!" << std::endl;
+        return false;
+    }
+}
+
 bool deleteSignal(const std::string& name) {
     auto path = getLibraryDirectory() + name + ".sig";
     return fs::remove(path);
@@ -316,6 +420,18 @@ bool exportSignal(const Signal &signal, const std::string &filePath, FileFormat
             file.close();
             return true;
         }
+        else if (format == FileFormat::RAW)
+        {
+            std::vector<float> pcm(buffer.begin(), buffer.end());
+            std::ofstream file;
+            file.open(path, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(pcm.data()), pcm.size() * sizeof(float));
+            if (!file) {
+                std::cout << "Failed to save " << path << std::endl;
+                return false;
+            }
+            return true;
+        }
 
         return false;
     }
@@ -370,7 +486,20 @@ bool importSignal(Signal &signal, const std::string &filePath, FileFormat format
                 std::cout << "Failed to load audio file!" << std::endl;
                 return false;
             }
-            signal = Samples(std::move(audioFile.samples[0]), (double)audioFile.getSampleRate());
+            Samples samples(std::move(audioFile.samples[0]), (double)audioFile.getSampleRate());
+            signal = samples.resample(sampleRate);
+            return true;
+        }
+
+        if (format == FileFormat::RAW) {
+            if (sampleRate <= 0)
+                sampleRate = 48000; // RAW files don't store their rate
+            auto file = std::make_shared<MappedFile>();
+            if (!file->open(path.string()))
+                return false;
+            auto data = static_cast<const float*>(file->data());
+            std::size_t count = file->size() / sizeof(float);
+            signal = Samples(std::move(file), data, count, (double)sampleRate);
             return true;
         }
 
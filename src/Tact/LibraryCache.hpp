@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Tact/Library.hpp>
+#include <unordered_map>
+#include <filesystem>
+#include <iostream>
+
+namespace tact {
+
+/// Caches Signals loaded from the Syntacts Library, reloading them only when their file changes
+class LibraryCache {
+public:
+
+    /// Returns a library Signal by name or nullptr if it could not be loaded
+    const Signal* get(const std::string& name) {
+        if (!validName(name)) {
+            std::cout << "Library Signal name " << name << " is not allowed" << std::endl;
+            return nullptr;
+        }
+        std::error_code ec;
+        auto time = std::filesystem::last_write_time(Library::getLibraryDirectory() + name + ".sig", ec);
+        if (ec) {
+            std::cout << "Library Signal " << name << " not found" << std::endl;
+            return nullptr;
+        }
+        auto it = m_signals.find(name);
+        if (it != m_signals.end() && it->second.time == time)
+            return &it->second.signal;
+        Signal signal;
+        if (!Library::loadSignal(signal, name))
+            return nullptr;
+        auto& entry = m_signals[name];
+        entry.signal = std::move(signal);
+        entry.time = time;
+        return &entry.signal;
+    }
+
+    /// Releases all cached Signals
+    void clear() {
+        m_signals.clear();
+    }
+
+private:
+    /// Returns true if name can only refer to a file inside the library directory
+    static bool validName(const std::string& name) {
+        return !name.empty() && name.find_first_of(std::string("/\\:\0", 4)) == std::string::npos && name.find("..") == std::string::npos;
+    }
+
+    struct Entry {
+        Signal signal;
+        std::filesystem::file_time_type time;
+    };
+    std::unordered_map<std::string, Entry> m_signals;
+};
+
+} // namespace tact
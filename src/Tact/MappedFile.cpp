@@ -0,0 +1,100 @@
+#include "Tact/MappedFile.hpp"
+#include <iostream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace tact {
+
+MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_handle(nullptr) { }
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cout << "Failed to open " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL) {
+        std::cout << "Failed to map " << path << std::endl;
+        return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL) {
+        CloseHandle(mapping);
+        std::cout << "Failed to map " << path << std::endl;
+        return false;
+    }
+    m_data = data; m_size = static_cast<std::size_t>(size.QuadPart); m_handle = mapping;
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_handle)
+        CloseHandle(m_handle);
+    m_data = nullptr; m_size = 0; m_handle = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cout << "Failed to open " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        std::cout << "Failed to map " << path << std::endl;
+        return false;
+    }
+    m_data = data; m_size = size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (m_data)
+        munmap(const_cast<void*>(m_data), m_size);
+    m_data = nullptr; m_size = 0;
+}
+
+#endif
+
+const void* MappedFile::data() const {
+    return m_data;
+}
+
+std::size_t MappedFile::size() const {
+    return m_size;
+}
+
+} // namespace tact
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace tact {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// Read-only memory mapping of an entire file. Pages are loaded on demand and
+/// shared with every other process mapping the same file.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+    /// Maps the file at path. Returns false if it can't be opened or is empty.
+    bool open(const std::string& path);
+    /// Unmaps the file.
+    void close();
+    /// Returns the mapped memory or nullptr.
+    const void* data() const;
+    /// Returns the size of the mapping in bytes.
+    std::size_t size() const;
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    const void* m_data;
+    std::size_t m_size;
+    void* m_handle;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace tact
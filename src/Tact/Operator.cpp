@@ -4,6 +4,13 @@
 namespace tact
 {
 
+namespace {
+
+// samples of the right operand rendered at a time by block sampling
+constexpr int OPERATOR_BLOCK = 64;
+
+} // namespace
+
 IOperator::IOperator(Signal _lhs, Signal _rhs) :
     lhs(std::move(_lhs)), rhs(std::move(_rhs))
 { }
@@ -12,16 +19,74 @@ double Sum::sample(double t) const {
     return lhs.sample(t) + rhs.sample(t);
 }
 
+void Sum::sample(const double* t, double* b, int n) const {
+    double r[OPERATOR_BLOCK];
+    if (n <= 0)
+        return;
+    // skip operands that are silent for the whole block
+    auto span = std::minmax_element(t, t + n);
+    if (rhs.silent(*span.first, *span.second)) {
+        lhs.sample(t, b, n);
+        return;
+    }
+    if (lhs.silent(*span.first, *span.second))
+        std::fill(b, b + n, 0.0);
+    else
+        lhs.sample(t, b, n);
+    for (int i = 0; i < n; i += OPERATOR_BLOCK) {
+        int m = std::min(OPERATOR_BLOCK, n - i);
+        rhs.sample(t + i, r, m);
+        for (int j = 0; j < m; ++j)
+            b[i + j] += r[j];
+    }
+}
+
 double Sum::length() const {
     return std::max(lhs.length(), rhs.length());
 }
 
+double Sum::peak() const {
+    return lhs.peak() + rhs.peak();
+}
+
+bool Sum::silent(double t0, double t1) const {
+    return lhs.silent(t0, t1) && rhs.silent(t0, t1);
+}
+
 double Product::sample(double t) const {
     return lhs.sample(t) * rhs.sample(t);
 }
 
+void Product::sample(const double* t, double* b, int n) const {
+    double r[OPERATOR_BLOCK];
+    if (n <= 0)
+        return;
+    // a silent factor makes the whole block silent without sampling the other
+    auto span = std::minmax_element(t, t + n);
+    if (lhs.silent(*span.first, *span.second) || rhs.silent(*span.first, *span.second)) {
+        std::fill(b, b + n, 0.0);
+        return;
+    }
+    lhs.sample(t, b, n);
+    for (int i = 0; i < n; i += OPERATOR_BLOCK) {
+        int m = std::min(OPERATOR_BLOCK, n - i);
+        rhs.sample(t + i, r, m);
+        for (int j = 0; j < m; ++j)
+            b[i + j] *= r[j];
+    }
+}
+
 double Product::length() const {
     return std::min(lhs.length(), rhs.length());
 }
 
+double Product::peak() const {
+    double l = lhs.peak(), r = rhs.peak();
+    return l == 0 || r == 0 ? 0 : l * r;
+}
+
+bool Product::silent(double t0, double t1) const {
+    return lhs.silent(t0, t1) || rhs.silent(t0, t1);
+}
+
 } // namespace tact
@@ -1,9 +1,150 @@
 #include <Tact/Oscillator.hpp>
 #include <Tact/Operator.hpp>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
 
 namespace tact
 {
 
+namespace {
+
+/// Returns sin(2*pi*u) with a branch-free polynomial (error < 1e-11) so block loops can vectorize
+inline double sinTurns(double u) {
+    constexpr double ROUND = 6755399441055744.0;          // 1.5 * 2^52, rounds to nearest integer when added
+    u -= (u + ROUND) - ROUND;                              // [-0.5, 0.5] (exact for |u| < 2^51)
+    double a = std::abs(u);
+    double w = TWO_PI * std::min(a, 0.5 - a);              // sin(2*pi*a) = sin(2*pi*(0.5-a)), w in [0, pi/2]
+    double w2 = w * w;
+    double p = -7.647163731819816e-13;                     // odd Taylor series through w^15
+    p = p * w2 + 1.6059043836821613e-10;
+    p = p * w2 - 2.505210838544172e-08;
+    p = p * w2 + 2.7557319223985893e-06;
+    p = p * w2 - 1.984126984126984e-04;
+    p = p * w2 + 8.333333333333333e-03;
+    p = p * w2 - 1.6666666666666666e-01;
+    p = p * w2 + 1.0;
+    return std::copysign(w * p, u);
+}
+
+// samples per table cycle (a power of two, so indices wrap with a mask)
+constexpr int TABLE_SIZE = 4096;
+// harmonics in the first table level (keeps the highest harmonic at 4 samples per period)
+constexpr int TABLE_HARMONICS = TABLE_SIZE / 4;
+// table levels, from TABLE_HARMONICS harmonics down to 1
+constexpr int TABLE_LEVELS = 11;
+// time step used to estimate the input frequency when sampling a single time
+constexpr double TABLE_STEP = 1e-4;
+
+} // namespace
+
+/// Band-limited table levels built from the Fourier series of one cycle.
+class Wavetable::Table {
+public:
+    /// Builds the levels of dc + sum(a[k] cos(k theta) + b[k] sin(k theta)) for k = 1..TABLE_HARMONICS.
+    Table(double dc, const std::vector<double>& a, const std::vector<double>& b) :
+        data(TABLE_LEVELS * (TABLE_SIZE + 1)), peak(0)
+    {
+        std::vector<double> cosTab(TABLE_SIZE), sinTab(TABLE_SIZE), acc(TABLE_SIZE, dc);
+        for (int j = 0; j < TABLE_SIZE; ++j) {
+            cosTab[j] = std::cos(TWO_PI * j / TABLE_SIZE);
+            sinTab[j] = std::sin(TWO_PI * j / TABLE_SIZE);
+        }
+        // levels are nested, so build from the fewest harmonics up and add only the new ones
+        int built = 0;
+        for (int level = TABLE_LEVELS - 1; level >= 0; --level) {
+            int harmonics = TABLE_HARMONICS >> level;
+            for (int k = built + 1; k <= harmonics; ++k) {
+                if (a[k] == 0 && b[k] == 0)
+                    continue;
+                for (int j = 0; j < TABLE_SIZE; ++j) {
+                    int idx = (k * j) & (TABLE_SIZE - 1);
+                    acc[j] += a[k] * cosTab[idx] + b[k] * sinTab[idx];
+                }
+            }
+            built = harmonics;
+            float* out = &data[level * (TABLE_SIZE + 1)];
+            for (int j = 0; j < TABLE_SIZE; ++j) {
+                out[j] = static_cast<float>(acc[j]);
+                peak = std::max(peak, std::abs(acc[j]));
+            }
+            out[TABLE_SIZE] = out[0]; // guard sample for interpolation
+        }
+    }
+
+    /// Builds the levels of one cycle sampled at TABLE_SIZE evenly spaced points.
+    static std::shared_ptr<const Table> fromCycle(const std::vector<float>& cycle) {
+        std::vector<double> a(TABLE_HARMONICS + 1, 0), b(TABLE_HARMONICS + 1, 0);
+        double dc = 0;
+        for (int j = 0; j < TABLE_SIZE; ++j)
+            dc += cycle[j];
+        dc /= TABLE_SIZE;
+        std::vector<double> cosTab(TABLE_SIZE), sinTab(TABLE_SIZE);
+        for (int j = 0; j < TABLE_SIZE; ++j) {
+            cosTab[j] = std::cos(TWO_PI * j / TABLE_SIZE);
+            sinTab[j] = std::sin(TWO_PI * j / TABLE_SIZE);
+        }
+        for (int k = 1; k <= TABLE_HARMONICS; ++k) {
+            double ak = 0, bk = 0;
+            for (int j = 0; j < TABLE_SIZE; ++j) {
+                int idx = (k * j) & (TABLE_SIZE - 1);
+                ak += cycle[j] * cosTab[idx];
+                bk += cycle[j] * sinTab[idx];
+            }
+            a[k] = 2 * ak / TABLE_SIZE;
+            b[k] = 2 * bk / TABLE_SIZE;
+        }
+        return std::make_shared<const Table>(dc, a, b);
+    }
+
+    /// Returns the shared table of a built-in shape, building it on first use.
+    static std::shared_ptr<const Table> builtIn(Shape shape) {
+        static std::shared_ptr<const Table> tables[4];
+        static std::once_flag flags[4];
+        int i = static_cast<int>(shape);
+        std::call_once(flags[i], [&]() {
+            std::vector<double> a(TABLE_HARMONICS + 1, 0), b(TABLE_HARMONICS + 1, 0);
+            for (int k = 1; k <= TABLE_HARMONICS; ++k) {
+                if (shape == Shape::Sine)
+                    b[k] = k == 1 ? 1 : 0;
+                else if (shape == Shape::Square)
+                    b[k] = k % 2 ? 4 * INV_PI / k : 0;
+                else if (shape == Shape::Saw)
+                    b[k] = -2 * INV_PI / k;
+                else // Triangle
+                    b[k] = k % 2 ? ((k / 2) % 2 ? -8 : 8) * INV_PI * INV_PI / (k * k) : 0;
+            }
+            tables[i] = std::make_shared<const Table>(0, a, b);
+        });
+        return tables[i];
+    }
+
+    /// Returns the level whose harmonics stay under band at hertz.
+    const float* level(double hertz, double band = WAVETABLE_BAND) const {
+        double ratio = std::abs(hertz) * TABLE_HARMONICS / band;
+        int level = 0;
+        if (ratio > 1) {
+            int e;
+            double m = std::frexp(ratio, &e); // ratio = m * 2^e, ceil(log2(ratio)) = e unless m == 0.5
+            level = std::min(m == 0.5 ? e - 1 : e, TABLE_LEVELS - 1);
+        }
+        return &data[level * (TABLE_SIZE + 1)];
+    }
+
+    /// Linearly interpolates a level at phase x in radians.
+    static inline double read(const float* level, double x) {
+        double u = x * (0.5 * INV_PI);
+        double p = (u - std::floor(u)) * TABLE_SIZE;
+        int i = static_cast<int>(p);
+        double f = p - i;
+        i &= TABLE_SIZE - 1; // u - floor(u) can round up to 1
+        return level[i] + f * (level[i + 1] - level[i]);
+    }
+
+    std::vector<float> data; ///< TABLE_LEVELS levels of TABLE_SIZE + 1 samples
+    double peak;             ///< largest magnitude in any level
+};
+
 IOscillator::IOscillator() :
     IOscillator(100)
 { }
@@ -13,7 +154,7 @@ IOscillator::IOscillator(double hertz) :
 { }
 
 IOscillator::IOscillator(double initial, double rate) :
-    x(std::move( ( TWO_PI * initial + PI * rate * Time() ) * Time() ))
+    x(ChirpPhase(initial, rate))
 { }
 
 IOscillator::IOscillator(Signal _x) :
@@ -21,12 +162,112 @@ IOscillator::IOscillator(Signal _x) :
 { }
 
 IOscillator::IOscillator(double hertz, Signal modulation, double index) :
-    x(std::move(TWO_PI * hertz * Time() + index * modulation))
+    x(FmPhase(hertz, std::move(modulation), index))
+{ }
+
+ChirpPhase::ChirpPhase(double _initial, double _rate) :
+    initial(_initial), rate(_rate)
+{ }
+
+FmPhase::FmPhase(double _frequency, Signal _modulation, double _index) :
+    frequency(_frequency), modulation(std::move(_modulation)), index(_index)
+{ }
+
+Chirp::Chirp(double _initial, double _rate) :
+    initial(_initial), rate(_rate)
 { }
 
+void Chirp::sample(const double* t, double* b, int n) const {
+    const double c = 0.5 * rate;
+    for (int i = 0; i < n; ++i)
+        b[i] = sinTurns(t[i] * (initial + c * t[i]));
+}
+
+FmSine::FmSine(double _frequency, double _modulation, double _index) :
+    frequency(_frequency), modulation(_modulation), index(_index)
+{ }
+
+void FmSine::sample(const double* t, double* b, int n) const {
+    const double k = index * 0.5 * INV_PI;
+    for (int i = 0; i < n; ++i)
+        b[i] = sinTurns(frequency * t[i] + k * sinTurns(modulation * t[i]));
+}
+
 Pwm::Pwm(double _frequency, double _dutyCycle) :
     frequency(_frequency), 
     dutyCycle(clamp01(_dutyCycle))
 { }
 
+Wavetable::Wavetable(Shape shape, double hertz) :
+    IOscillator(hertz), m_shape(shape)
+{ 
+    build();
+}
+
+Wavetable::Wavetable(Shape shape, Signal _x) :
+    IOscillator(std::move(_x)), m_shape(shape)
+{ 
+    build();
+}
+
+Wavetable::Wavetable(const Signal& cycle, double hertz) :
+    Wavetable(cycle, TWO_PI * hertz * Time())
+{ }
+
+Wavetable::Wavetable(const Signal& cycle, Signal _x) :
+    IOscillator(std::move(_x)), m_shape(Shape::Custom), m_cycle(TABLE_SIZE)
+{
+    // infinite Signals have no natural cycle, so one second of them is used
+    double length = cycle.finite() ? cycle.length() : 1;
+    std::vector<double> t(TABLE_SIZE), b(TABLE_SIZE);
+    for (int j = 0; j < TABLE_SIZE; ++j)
+        t[j] = j * length / TABLE_SIZE;
+    cycle.sample(t.data(), b.data(), TABLE_SIZE);
+    std::copy(b.begin(), b.end(), m_cycle.begin());
+    build();
+}
+
+void Wavetable::build() {
+    if (m_shape == Shape::Custom && m_cycle.size() == TABLE_SIZE)
+        m_table = Table::fromCycle(m_cycle);
+    else
+        m_table = Table::builtIn(m_shape == Shape::Custom ? Shape::Sine : m_shape);
+}
+
+double Wavetable::hertz(double t, double phase) const {
+    if (x.isType<Time>())
+        return x.gain * (0.5 * INV_PI);
+    return (x.sample(t + TABLE_STEP) - phase) / TABLE_STEP * (0.5 * INV_PI);
+}
+
+double Wavetable::sample(double t) const {
+    double phase = x.sample(t);
+    return Table::read(m_table->level(hertz(t, phase)), phase);
+}
+
+void Wavetable::sample(const double* t, double* b, int n) const {
+    if (n <= 0)
+        return;
+    x.sample(t, b, n);
+    // the step advancing the input most against the band it can carry picks the level, so harmonics
+    // stay under both WAVETABLE_BAND and the Nyquist frequency of the actual sample spacing
+    double ratio = 0;
+    for (int i = 1; i < n; ++i) {
+        double dt = std::abs(t[i] - t[i-1]);
+        if (dt != 0)
+            ratio = std::max(ratio, std::abs(b[i] - b[i-1]) * (0.5 * INV_PI) / std::min(WAVETABLE_BAND * dt, 0.5));
+    }
+    const float* level = n > 1 ? m_table->level(ratio, 1) : m_table->level(hertz(t[0], b[0]));
+    for (int i = 0; i < n; ++i)
+        b[i] = Table::read(level, b[i]);
+}
+
+double Wavetable::peak() const {
+    return m_table->peak;
+}
+
+Wavetable::Shape Wavetable::getShape() const {
+    return m_shape;
+}
+
 } // namespace tact
\ No newline at end of file
@@ -1,8 +1,59 @@
 #include <Tact/Process.hpp>
+#include <Tact/Util.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
 
 namespace tact
 {
 
+namespace {
+
+// samples rendered per block while baking
+constexpr int BAKE_BLOCK = 1024;
+
+} // namespace
+
+class BakedSignal {
+public:
+    std::vector<float> samples;
+    double sampleRate;
+    double length;
+
+    /// Renders signal at sampleRate, or returns nullptr if it can't be baked faithfully in maxSamples.
+    static std::shared_ptr<const BakedSignal> render(const Signal& signal, double sampleRate, int maxSamples) {
+        double length = signal.length();
+        if (!(sampleRate > 0) || !(length > 0) || length == INF || length * sampleRate >= maxSamples)
+            return nullptr;
+        auto baked = std::make_shared<BakedSignal>();
+        baked->sampleRate = sampleRate;
+        baked->length     = length;
+        baked->samples.resize(static_cast<std::size_t>(std::ceil(length * sampleRate)) + 1);
+        double t[BAKE_BLOCK], b[BAKE_BLOCK];
+        for (std::size_t i = 0; i < baked->samples.size(); i += BAKE_BLOCK) {
+            int n = static_cast<int>(std::min<std::size_t>(BAKE_BLOCK, baked->samples.size() - i));
+            for (int j = 0; j < n; ++j)
+                t[j] = std::min((i + j) / sampleRate, length);
+            signal.sample(t, b, n);
+            std::copy(b, b + n, baked->samples.begin() + i);
+        }
+        return baked;
+    }
+
+    /// Linearly interpolates the buffer at time t (clamped to [0, length]).
+    inline double sample(double t) const {
+        double x = t * sampleRate;
+        if (x <= 0)
+            return samples.front();
+        std::size_t i = static_cast<std::size_t>(x);
+        if (i + 1 >= samples.size())
+            return samples.back();
+        double f = x - i;
+        return samples[i] + (samples[i+1] - samples[i]) * f;
+    }
+};
+
 Repeater::Repeater() : repetitions(1),
                        delay(0)
 {
@@ -16,6 +67,14 @@ Repeater::Repeater(Signal _signal, int _repetitions, double _delay) : signal(std
 
 double Repeater::sample(double t) const
 {
+    if (m_baked) {
+        double sigLen = m_baked->length;
+        double intLen = sigLen + delay;
+        if (t > sigLen * repetitions + delay * (repetitions - 1))
+            return 0;
+        double s = t - std::floor(t / intLen) * intLen;
+        return s <= sigLen ? m_baked->sample(s) : 0;
+    }
     double sigLen = signal.length();
     double intLen = sigLen + delay;
     double maxLen = sigLen * repetitions + delay * (repetitions - 1);
@@ -36,6 +95,47 @@ double Repeater::length() const
     return signal.length() * repetitions + delay * (repetitions - 1);
 }
 
+double Repeater::peak() const
+{
+    return signal.peak();
+}
+
+bool Repeater::silent(double t0, double t1) const
+{
+    if (t0 > length())
+        return true;
+    double sigLen = signal.length();
+    double intLen = sigLen + delay;
+    if (!(intLen > 0) || intLen == INF)
+        return intLen == INF && signal.silent(t0, t1);
+    // only the repetition containing the whole interval is known
+    double c = std::floor(t0 / intLen);
+    if (std::floor(t1 / intLen) != c)
+        return false;
+    double s0 = t0 - c * intLen, s1 = t1 - c * intLen;
+    if (s0 > sigLen)
+        return true;
+    // the baked buffer interpolates neighboring samples
+    double pad = m_baked ? 1.0 / m_baked->sampleRate : 0;
+    return signal.silent(s0 - pad, std::min(s1, sigLen) + pad);
+}
+
+void Repeater::bake(double sampleRate, int maxSamples)
+{
+    if (!m_baked || m_baked->sampleRate != sampleRate)
+        m_baked = BakedSignal::render(signal, sampleRate, maxSamples);
+}
+
+void Repeater::unbake()
+{
+    m_baked = nullptr;
+}
+
+bool Repeater::isBaked() const
+{
+    return m_baked != nullptr;
+}
+
 Stretcher::Stretcher() : factor(1) {}
 
 Stretcher::Stretcher(Signal _signal, double _factor) : signal(_signal),
@@ -53,6 +153,19 @@ double Stretcher::length() const
     return signal.length() * factor;
 }
 
+double Stretcher::peak() const
+{
+    return signal.peak();
+}
+
+bool Stretcher::silent(double t0, double t1) const
+{
+    if (factor == 0)
+        return false;
+    double s0 = t0 / factor, s1 = t1 / factor;
+    return signal.silent(std::min(s0, s1), std::max(s0, s1));
+}
+
 Reverser::Reverser()
 {
 }
@@ -63,6 +176,10 @@ Reverser::Reverser(Signal _signal) : signal(std::move(_signal))
 
 double Reverser::sample(double t) const
 {
+    if (m_baked) {
+        double l = m_baked->length;
+        return m_baked->sample(clamp(l - t, 0, l));
+    }
     double l = signal.length();
     l = l == INF ? 1000000000 : l;
     t = clamp(l - t, 0, 1000000000);
@@ -74,4 +191,84 @@ double Reverser::length() const
     return signal.length();
 }
 
+double Reverser::peak() const
+{
+    return signal.peak();
+}
+
+void Reverser::bake(double sampleRate, int maxSamples)
+{
+    if (!m_baked || m_baked->sampleRate != sampleRate)
+        m_baked = BakedSignal::render(signal, sampleRate, maxSamples);
+}
+
+void Reverser::unbake()
+{
+    m_baked = nullptr;
+}
+
+bool Reverser::isBaked() const
+{
+    return m_baked != nullptr;
+}
+
+ControlRate::ControlRate() : rate(1000)
+{
+}
+
+ControlRate::ControlRate(Signal _signal, double _rate) : signal(std::move(_signal)),
+                                                         rate(_rate)
+{
+}
+
+double ControlRate::sample(double t) const
+{
+    if (!(rate > 0))
+        return signal.sample(t);
+    double x = t * rate;
+    double k = std::floor(x);
+    double v0 = signal.sample(k / rate);
+    double v1 = signal.sample((k + 1) / rate);
+    return v0 + (v1 - v0) * (x - k);
+}
+
+void ControlRate::sample(const double* t, double* b, int n) const
+{
+    if (!(rate > 0)) {
+        signal.sample(t, b, n);
+        return;
+    }
+    // control period of the last sample, and the Signal at its start and end
+    double k0 = std::numeric_limits<double>::quiet_NaN(), v0 = 0, v1 = 0;
+    for (int i = 0; i < n; ++i) {
+        double x = t[i] * rate;
+        double k = std::floor(x);
+        if (k != k0) {
+            v0 = k == k0 + 1 ? v1 : signal.sample(k / rate);
+            v1 = signal.sample((k + 1) / rate);
+            k0 = k;
+        }
+        b[i] = v0 + (v1 - v0) * (x - k);
+    }
+}
+
+double ControlRate::length() const
+{
+    return signal.length();
+}
+
+double ControlRate::peak() const
+{
+    // linear interpolation stays between the control values
+    return signal.peak();
+}
+
+bool ControlRate::silent(double t0, double t1) const
+{
+    if (!(rate > 0))
+        return signal.silent(t0, t1);
+    // samples interpolate the control times around them
+    return signal.silent(std::floor(t0 * rate) / rate, (std::floor(t1 * rate) + 1) / rate);
+}
+
 } // namespace tact
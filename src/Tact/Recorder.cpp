@@ -0,0 +1,175 @@
+#include "Tact/Recorder.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <vector>
+
+namespace tact {
+
+namespace {
+
+constexpr double RING_SECONDS  = 2.0;        // audio buffered between the callback and the writer
+constexpr std::size_t CHUNK    = 64 * 1024;  // floats per file write
+constexpr auto WRITER_PERIOD   = std::chrono::milliseconds(10);
+
+constexpr std::uint16_t WAVE_FORMAT_IEEE_FLOAT = 0x0003;
+constexpr std::uint16_t WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+// KSDATAFORMAT_SUBTYPE_IEEE_FLOAT
+constexpr std::uint8_t SUBTYPE_IEEE_FLOAT[16] = {
+    0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xAA, 0x00, 0x38, 0x9B, 0x71
+};
+
+template <typename T>
+void put(std::ofstream& file, T value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+std::size_t nextPowerOfTwo(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+} // namespace
+
+Recorder::Recorder() :
+    m_wav(false), m_channels(0), m_sampleRate(0), m_mask(0),
+    m_head(0), m_tail(0), m_dropped(0), m_written(0), m_failed(false), m_running(false)
+{ }
+
+Recorder::~Recorder() {
+    close();
+}
+
+bool Recorder::open(const std::string& filePath, int channels, double sampleRate) {
+    close();
+    m_file.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!m_file)
+        return false;
+    auto ext = std::filesystem::path(filePath).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    m_wav        = ext == ".wav" || ext == ".wave";
+    m_channels   = channels;
+    m_sampleRate = sampleRate;
+    std::size_t capacity = nextPowerOfTwo(static_cast<std::size_t>(sampleRate * RING_SECONDS) * channels);
+    m_ring       = std::make_unique<float[]>(capacity);
+    m_mask       = capacity - 1;
+    m_head       = 0;
+    m_tail       = 0;
+    m_dropped    = 0;
+    m_written    = 0;
+    m_failed     = false;
+    if (m_wav)
+        writeHeader(0);
+    if (!m_file) {
+        m_file.close();
+        return false;
+    }
+    m_running = true;
+    m_thread = std::thread(&Recorder::writeLoop, this);
+    return true;
+}
+
+void Recorder::write(float** buffers, unsigned long frames) {
+    std::size_t head  = m_head.load(std::memory_order_relaxed);
+    std::size_t tail  = m_tail.load(std::memory_order_acquire);
+    std::size_t count = frames * m_channels;
+    if (m_mask + 1 - (head - tail) < count) {
+        m_dropped.fetch_add(frames, std::memory_order_relaxed);
+        return;
+    }
+    for (unsigned long f = 0; f < frames; ++f) {
+        for (int c = 0; c < m_channels; ++c)
+            m_ring[(head++) & m_mask] = buffers[c][f];
+    }
+    m_head.store(head, std::memory_order_release);
+}
+
+bool Recorder::close() {
+    if (!m_running)
+        return true;
+    m_running = false;
+    if (m_thread.joinable())
+        m_thread.join();
+    drain();
+    if (m_wav && !m_failed) {
+        m_file.seekp(0);
+        writeHeader(m_written);
+    }
+    m_file.close();
+    m_failed = m_failed || m_file.fail();
+    m_ring.reset();
+    return !m_failed;
+}
+
+std::uint64_t Recorder::getDroppedFrames() const {
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+void Recorder::writeLoop() {
+    while (m_running) {
+        drain();
+        std::this_thread::sleep_for(WRITER_PERIOD);
+    }
+}
+
+void Recorder::drain() {
+    std::size_t tail = m_tail.load(std::memory_order_relaxed);
+    std::size_t head = m_head.load(std::memory_order_acquire);
+    while (tail != head) {
+        std::size_t offset = tail & m_mask;
+        std::size_t count  = std::min({head - tail, m_mask + 1 - offset, CHUNK});
+        // after a failed write the ring is still emptied so the audio thread never stalls
+        if (!m_failed && !m_file.write(reinterpret_cast<const char*>(&m_ring[offset]), count * sizeof(float)))
+            m_failed = true;
+        tail += count;
+        m_tail.store(tail, std::memory_order_release);
+    }
+    if (!m_failed)
+        m_written = tail / m_channels;
+}
+
+void Recorder::writeHeader(std::uint64_t frames) {
+    // RIFF sizes are 32-bit, so recordings longer than 4 GB keep a saturated header whose
+    // data size is the largest whole number of frames that keeps the RIFF size from wrapping
+    bool extensible = m_channels > 2;
+    std::uint32_t fmtSize    = extensible ? 40 : 18;
+    std::uint32_t headerSize = 4 + (8 + fmtSize) + (8 + 4) + 8;
+    std::uint16_t blockAlign = static_cast<std::uint16_t>(m_channels * sizeof(float));
+    std::uint64_t dataBytes  = frames * blockAlign;
+    std::uint64_t maxData    = std::numeric_limits<std::uint32_t>::max() - headerSize;
+    std::uint32_t dataSize   = static_cast<std::uint32_t>(std::min<std::uint64_t>(dataBytes, maxData - maxData % blockAlign));
+    std::uint32_t riffSize   = headerSize + dataSize;
+    m_file.write("RIFF", 4);
+    put<std::uint32_t>(m_file, riffSize);
+    m_file.write("WAVE", 4);
+    m_file.write("fmt ", 4);
+    put<std::uint32_t>(m_file, fmtSize);
+    put<std::uint16_t>(m_file, extensible ? WAVE_FORMAT_EXTENSIBLE : WAVE_FORMAT_IEEE_FLOAT);
+    put<std::uint16_t>(m_file, static_cast<std::uint16_t>(m_channels));
+    put<std::uint32_t>(m_file, static_cast<std::uint32_t>(m_sampleRate));
+    put<std::uint32_t>(m_file, static_cast<std::uint32_t>(m_sampleRate) * blockAlign);
+    put<std::uint16_t>(m_file, blockAlign);
+    put<std::uint16_t>(m_file, 32);
+    if (extensible) {
+        put<std::uint16_t>(m_file, 22);
+        put<std::uint16_t>(m_file, 32);
+        put<std::uint32_t>(m_file, 0); // no speaker positions
+        m_file.write(reinterpret_cast<const char*>(SUBTYPE_IEEE_FLOAT), 16);
+    }
+    else {
+        put<std::uint16_t>(m_file, 0);
+    }
+    m_file.write("fact", 4);
+    put<std::uint32_t>(m_file, 4);
+    put<std::uint32_t>(m_file, static_cast<std::uint32_t>(std::min<std::uint64_t>(frames, std::numeric_limits<std::uint32_t>::max())));
+    m_file.write("data", 4);
+    put<std::uint32_t>(m_file, dataSize);
+}
+
+} // namespace tact
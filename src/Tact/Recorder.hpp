@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace tact {
+
+/// Streams rendered Session output to a WAV or raw float file. The audio thread copies frames
+/// into a lock-free ring and a writer thread empties it with large sequential writes.
+class Recorder {
+public:
+    Recorder();
+    ~Recorder();
+
+    /// Opens a file (.wav for 32-bit float WAV, anything else for raw interleaved float) and starts the writer thread.
+    bool open(const std::string& filePath, int channels, double sampleRate);
+
+    /// Copies non-interleaved output buffers into the ring (audio thread only, never blocks).
+    void write(float** buffers, unsigned long frames);
+
+    /// Drains the ring, finalizes the file and joins the writer thread. Returns false if any write failed.
+    bool close();
+
+    /// Returns the number of frames dropped because the writer fell behind.
+    std::uint64_t getDroppedFrames() const;
+
+private:
+    void writeLoop();
+    void drain();
+    void writeHeader(std::uint64_t frames);
+
+    std::ofstream m_file;
+    bool m_wav;
+    int m_channels;
+    double m_sampleRate;
+    std::unique_ptr<float[]> m_ring;
+    std::size_t m_mask;
+    std::atomic<std::size_t> m_head; ///< next float written by the audio thread
+    std::atomic<std::size_t> m_tail; ///< next float read by the writer thread
+    std::atomic<std::uint64_t> m_dropped;
+    std::uint64_t m_written;         ///< frames written to the file
+    bool m_failed;                   ///< true once a file write has failed (later frames are discarded)
+    std::atomic<bool> m_running;
+    std::thread m_thread;
+};
+
+} // namespace tact
@@ -1,61 +1,266 @@
 #include <Tact/Sequence.hpp>
 #include <iostream>
 #include <algorithm>
+#include <functional>
+#include <queue>
 
 namespace tact {
 
-Sequence::Sequence() : head(0), m_keys(0), m_length(0)
+namespace {
+
+// forward cursor steps tried before falling back to binary search
+constexpr std::size_t CURSOR_STEPS = 8;
+// samples of a key rendered at a time by block sampling
+constexpr int SEQUENCE_BLOCK = 64;
+
+inline std::uint64_t packCursor(std::size_t lo, std::size_t hi) {
+    return (static_cast<std::uint64_t>(lo) << 32) | static_cast<std::uint32_t>(hi);
+}
+
+} // namespace
+
+Sequence::Sequence() : head(0), m_keys(0), m_length(0), m_cursor(0)
 { 
 }
 
+Sequence::Sequence(const Sequence& other) :
+    head(other.head), m_keys(other.m_keys), m_ends(other.m_ends), m_maxEnds(other.m_maxEnds),
+    m_length(other.m_length), m_cursor(other.m_cursor.load(std::memory_order_relaxed))
+{
+}
+
+Sequence::Sequence(Sequence&& other) noexcept :
+    head(other.head), m_keys(std::move(other.m_keys)), m_ends(std::move(other.m_ends)), 
+    m_maxEnds(std::move(other.m_maxEnds)), m_length(other.m_length), 
+    m_cursor(other.m_cursor.load(std::memory_order_relaxed))
+{
+}
+
+Sequence& Sequence::operator=(const Sequence& other) {
+    head     = other.head;
+    m_keys   = other.m_keys;
+    m_ends   = other.m_ends;
+    m_maxEnds = other.m_maxEnds;
+    m_length = other.m_length;
+    m_cursor.store(other.m_cursor.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+Sequence& Sequence::operator=(Sequence&& other) noexcept {
+    head     = other.head;
+    m_keys   = std::move(other.m_keys);
+    m_ends   = std::move(other.m_ends);
+    m_maxEnds = std::move(other.m_maxEnds);
+    m_length = other.m_length;
+    m_cursor.store(other.m_cursor.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
 Sequence& Sequence::push(double t) {
     head += t;
     return *this;
 }
 
 Sequence& Sequence::push(Signal signal) {
-    insert(signal, head);
-    head += signal.length();
+    double length = signal.length();
+    insertKey(std::move(signal), head, length);
+    head += length;
     return *this;
 }
 
 Sequence& Sequence::push(Sequence sequence) {
-    insert(sequence, head);
-    head += sequence.length();
+    double length = sequence.length();
+    insert(std::move(sequence), head);
+    head += length;
     return *this;
 }
 
 Sequence& Sequence::insert(Signal signal, double t) 
 {
-    m_length = std::max(m_length, t + signal.length());
-    m_keys.push_back({t, std::move(signal)});
+    double length = signal.length();
+    insertKey(std::move(signal), t, length);
     return *this;
 }
 
 Sequence& Sequence::insert(Sequence sequence, double t) {
     m_length = std::max(m_length, t + sequence.length());
+    if (sequence.m_keys.empty())
+        return *this;
+    // append everything, then merge the two sorted runs once
+    std::size_t mid = m_keys.size();
+    m_keys.reserve(mid + sequence.m_keys.size());
     for (auto& k : sequence.m_keys)
-        insert(k.signal, t + k.t);
+        m_keys.push_back({t + k.t, std::move(k.signal)});
+    // keys before the first one the merge moves keep their index entries
+    auto byTime = [](const Key& a, const Key& b) { return a.t < b.t; };
+    std::size_t from = std::upper_bound(m_keys.begin(), m_keys.begin() + mid, m_keys[mid], byTime) - m_keys.begin();
+    if (from < mid)
+        std::inplace_merge(m_keys.begin() + from, m_keys.begin() + mid, m_keys.end(), byTime);
+    rebuildIndex(from);
+    return *this;
+}
+
+Sequence& Sequence::pushNested(Sequence sequence) {
+    double length = sequence.length();
+    insertKey(SequenceRef(std::move(sequence)), head, length);
+    head += length;
+    return *this;
+}
+
+Sequence& Sequence::insertNested(Sequence sequence, double t) {
+    double length = sequence.length();
+    insertKey(SequenceRef(std::move(sequence)), t, length);
     return *this;
 }
 
+void Sequence::insertKey(Signal signal, double t, double length) {
+    m_length = std::max(m_length, t + length);
+    // keys pushed in order append in O(1); others go after existing keys with the same time
+    auto it = m_keys.end();
+    if (!m_keys.empty() && m_keys.back().t > t)
+        it = std::upper_bound(m_keys.begin(), m_keys.end(), t, [](double t, const Key& k) { return t < k.t; });
+    std::size_t idx = it - m_keys.begin();
+    m_keys.insert(it, {t, std::move(signal)});
+    m_ends.insert(m_ends.begin() + idx, t + length);
+    m_maxEnds.resize(m_keys.size());
+    for (std::size_t i = idx; i < m_keys.size(); ++i)
+        m_maxEnds[i] = i == 0 ? m_ends[i] : std::max(m_maxEnds[i - 1], m_ends[i]);
+    m_cursor.store(0, std::memory_order_relaxed);
+}
+
+void Sequence::rebuildIndex(std::size_t from) {
+    m_ends.resize(m_keys.size());
+    m_maxEnds.resize(m_keys.size());
+    for (std::size_t i = from; i < m_keys.size(); ++i) {
+        m_ends[i]    = m_keys[i].t + m_keys[i].signal.length();
+        m_maxEnds[i] = i == 0 ? m_ends[i] : std::max(m_maxEnds[i - 1], m_ends[i]);
+    }
+    m_cursor.store(0, std::memory_order_relaxed);
+}
+
+void Sequence::findRange(double t, std::size_t& lo, std::size_t& hi) const {
+    const std::size_t n = m_keys.size();
+    std::uint64_t cursor = m_cursor.load(std::memory_order_relaxed);
+    lo = static_cast<std::size_t>(cursor >> 32);
+    hi = static_cast<std::size_t>(cursor & 0xFFFFFFFF);
+    // lo: first key whose running max end reaches t (nothing before it can overlap t)
+    if (lo > n || (lo > 0 && m_maxEnds[lo - 1] >= t))
+        lo = std::lower_bound(m_maxEnds.begin(), m_maxEnds.end(), t) - m_maxEnds.begin();
+    else {
+        std::size_t steps = 0;
+        while (lo < n && m_maxEnds[lo] < t && ++steps < CURSOR_STEPS)
+            ++lo;
+        if (lo < n && m_maxEnds[lo] < t)
+            lo = std::lower_bound(m_maxEnds.begin() + lo, m_maxEnds.end(), t) - m_maxEnds.begin();
+    }
+    // hi: first key starting after t
+    auto startsAfter = [](double t, const Key& k) { return t < k.t; };
+    if (hi > n || (hi > 0 && m_keys[hi - 1].t > t))
+        hi = std::upper_bound(m_keys.begin(), m_keys.end(), t, startsAfter) - m_keys.begin();
+    else {
+        std::size_t steps = 0;
+        while (hi < n && m_keys[hi].t <= t && ++steps < CURSOR_STEPS)
+            ++hi;
+        if (hi < n && m_keys[hi].t <= t)
+            hi = std::upper_bound(m_keys.begin() + hi, m_keys.end(), t, startsAfter) - m_keys.begin();
+    }
+    m_cursor.store(packCursor(lo, hi), std::memory_order_relaxed);
+}
+
 double Sequence::sample(double t) const {
+    std::size_t lo, hi;
+    findRange(t, lo, hi);
     double sample = 0;
-    for (auto& k : m_keys) {
-        if (t >= k.t && t <= k.t + k.signal.length())
-            sample += k.signal.sample(t - k.t);
+    for (std::size_t i = lo; i < hi; ++i) {
+        if (t <= m_ends[i])
+            sample += m_keys[i].signal.sample(t - m_keys[i].t);
     }
     return sample;
 }
 
+void Sequence::findRange(double t0, double t1, std::size_t& lo, std::size_t& hi) const {
+    lo = std::lower_bound(m_maxEnds.begin(), m_maxEnds.end(), t0) - m_maxEnds.begin();
+    hi = std::upper_bound(m_keys.begin(), m_keys.end(), t1, [](double t, const Key& k) { return t < k.t; }) - m_keys.begin();
+}
+
+void Sequence::sample(const double* t, double* b, int n) const {
+    std::fill(b, b + n, 0.0);
+    if (n <= 0 || m_keys.empty())
+        return;
+    auto span = std::minmax_element(t, t + n);
+    double t0 = *span.first, t1 = *span.second;
+    std::size_t lo, hi;
+    findRange(t0, t1, lo, hi);
+    int idx[SEQUENCE_BLOCK];
+    double local[SEQUENCE_BLOCK], out[SEQUENCE_BLOCK];
+    // keys are summed in order, as sample(t) does
+    for (std::size_t i = lo; i < hi; ++i) {
+        const Key& key = m_keys[i];
+        double end = m_ends[i];
+        if (end < t0 || key.signal.silent(std::max(t0, key.t) - key.t, std::min(t1, end) - key.t))
+            continue;
+        int m = 0;
+        auto flush = [&]() {
+            key.signal.sample(local, out, m);
+            for (int j = 0; j < m; ++j)
+                b[idx[j]] += out[j];
+            m = 0;
+        };
+        for (int j = 0; j < n; ++j) {
+            if (t[j] >= key.t && t[j] <= end) {
+                idx[m]   = j;
+                local[m] = t[j] - key.t;
+                if (++m == SEQUENCE_BLOCK)
+                    flush();
+            }
+        }
+        if (m > 0)
+            flush();
+    }
+}
+
 double Sequence::length() const {
     return m_length;
 }
 
+double Sequence::peak() const {
+    // sweep keys in time order, summing the peaks of the keys that overlap each key's start
+    using Active = std::pair<double, double>; // end time, peak
+    std::priority_queue<Active, std::vector<Active>, std::greater<Active>> active;
+    double sum = 0, peak = 0;
+    for (std::size_t i = 0; i < m_keys.size(); ++i) {
+        while (!active.empty() && active.top().first < m_keys[i].t) {
+            sum -= active.top().second;
+            active.pop();
+        }
+        double p = m_keys[i].signal.peak();
+        if (p == INF)
+            return INF;
+        sum += p;
+        peak = std::max(peak, sum);
+        active.push({m_ends[i], p});
+    }
+    return peak;
+}
+
+bool Sequence::silent(double t0, double t1) const {
+    std::size_t lo, hi;
+    findRange(t0, t1, lo, hi);
+    for (std::size_t i = lo; i < hi; ++i) {
+        const Key& key = m_keys[i];
+        if (m_ends[i] >= t0 && !key.signal.silent(std::max(t0, key.t) - key.t, std::min(t1, m_ends[i]) - key.t))
+            return false;
+    }
+    return true;
+}
+
 void Sequence::clear() {
     m_keys.clear();
+    m_ends.clear();
+    m_maxEnds.clear();
     head = 0;
     m_length = 0;
+    m_cursor.store(0, std::memory_order_relaxed);
 }
 
 int Sequence::keyCount() const {
@@ -66,4 +271,20 @@ const Sequence::Key& Sequence::getKey(int idx) const {
     return m_keys[idx];
 }
 
-} // namespace tact
\ No newline at end of file
+///////////////////////////////////////////////////////////////////////////////
+
+SequenceRef::SequenceRef() : m_sequence(std::make_shared<Sequence>())
+{ }
+
+SequenceRef::SequenceRef(Sequence sequence) : m_sequence(std::make_shared<Sequence>(std::move(sequence)))
+{ }
+
+SequenceRef::SequenceRef(std::shared_ptr<const Sequence> sequence) : 
+    m_sequence(sequence ? std::move(sequence) : std::make_shared<const Sequence>())
+{ }
+
+const Sequence& SequenceRef::get() const {
+    return *m_sequence;
+}
+
+} // namespace tact
@@ -0,0 +1,172 @@
+#include <Tact/Server.hpp>
+#include <Tact/Library.hpp>
+#include "Tact/SharedMemory.hpp"
+#include "Tact/LibraryCache.hpp"
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+namespace tact {
+
+namespace {
+
+// number of empty polls spent yielding before the service thread starts sleeping
+constexpr int SPIN_POLLS = 20000;
+// sleep period of an idle service thread
+constexpr auto IDLE_SLEEP = std::chrono::microseconds(100);
+// time a claimed slot may stay unpublished before its client is assumed dead and the slot is reclaimed
+constexpr auto CLAIM_TIMEOUT = std::chrono::seconds(1);
+
+} // namespace
+
+class Server::Impl {
+public:
+
+    Impl(Session& session, const std::string& name) :
+        m_session(session), m_name(name), m_region(nullptr), m_running(false), m_count(0), m_stalled(false), m_stallPosition(0)
+    { }
+
+    ~Impl() {
+        stop();
+    }
+
+    int start() {
+        if (m_running)
+            return SyntactsError_NoError;
+        if (!m_session.isOpen())
+            return SyntactsError_NotOpen;
+        if (!m_mapping.create(m_name, sizeof(shm::Region)))
+            return SyntactsError_NotSupported;
+        m_region = static_cast<shm::Region*>(m_mapping.data());
+        shm::initialize(m_region, m_session.getChannelCount(), m_session.getSampleRate());
+        m_count = 0;
+        m_stalled = false;
+        m_running = true;
+        m_thread = std::thread(&Impl::service, this);
+        return SyntactsError_NoError;
+    }
+
+    void stop() {
+        if (!m_running)
+            return;
+        m_running = false;
+        if (m_thread.joinable())
+            m_thread.join();
+        // invalidate so connected clients stop writing into a dead ring
+        m_region->magic.store(0, std::memory_order_release);
+        m_mapping.close();
+        m_region = nullptr;
+        m_library.clear();
+    }
+
+    void service() {
+        int idle = 0;
+        while (m_running) {
+            shm::Slot* slot = shm::front(m_region);
+            if (slot) {
+                perform(*slot);
+                shm::pop(m_region);
+                m_count.fetch_add(1, std::memory_order_relaxed);
+                idle = 0;
+            }
+            else {
+                reclaimAbandoned();
+                if (++idle < SPIN_POLLS)
+                    std::this_thread::yield();
+                else
+                    std::this_thread::sleep_for(IDLE_SLEEP);
+            }
+        }
+    }
+
+    /// Skips the next slot if a client claimed it and didn't publish it within CLAIM_TIMEOUT, so the ring doesn't stall forever
+    void reclaimAbandoned() {
+        if (!shm::claimed(m_region)) {
+            m_stalled = false;
+            return;
+        }
+        auto position = m_region->head.load(std::memory_order_relaxed);
+        auto now = std::chrono::steady_clock::now();
+        if (!m_stalled || m_stallPosition != position) {
+            m_stalled       = true;
+            m_stallPosition = position;
+            m_stallTime     = now;
+        }
+        else if (now - m_stallTime >= CLAIM_TIMEOUT && shm::reclaim(m_region)) {
+            std::cout << "Reclaimed a command slot abandoned by a Client" << std::endl;
+            m_stalled = false;
+        }
+    }
+
+    void perform(const shm::Slot& slot) {
+        // read the size once, since clients share the slot, and reject sizes past the payload
+        std::size_t size = slot.size;
+        if (size > shm::PAYLOAD_SIZE)
+            return;
+        switch (slot.op) {
+            case shm::OpPlay: {
+                Signal signal;
+                if (Library::decodeSignal(signal, slot.payload, size))
+                    m_session.play(slot.channel, std::move(signal));
+                break;
+            }
+            case shm::OpPlayLibrary: {
+                const Signal* signal = m_library.get(std::string(slot.payload, size));
+                if (signal)
+                    m_session.play(slot.channel, *signal);
+                break;
+            }
+            case shm::OpStop:      m_session.stop(slot.channel);                break;
+            case shm::OpStopAll:   m_session.stopAll();                         break;
+            case shm::OpPause:     m_session.pause(slot.channel);               break;
+            case shm::OpResume:    m_session.resume(slot.channel);              break;
+            case shm::OpSetVolume: m_session.setVolume(slot.channel, slot.value); break;
+            case shm::OpSetPitch:  m_session.setPitch(slot.channel, slot.value);  break;
+            default: break;
+        }
+    }
+
+    Session& m_session;
+    std::string m_name;
+    shm::Mapping m_mapping;
+    shm::Region* m_region;
+    std::atomic<bool> m_running;
+    std::atomic<std::size_t> m_count;
+    std::thread m_thread;
+    LibraryCache m_library;
+    bool m_stalled;                                    ///< the next slot is claimed but unpublished
+    std::uint64_t m_stallPosition;                     ///< position of the stalled slot
+    std::chrono::steady_clock::time_point m_stallTime; ///< when the stalled slot was first seen
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// SERVER
+///////////////////////////////////////////////////////////////////////////////
+
+Server::Server(Session& session, const std::string& name) :
+    m_impl(std::make_unique<Server::Impl>(session, name))
+{ }
+
+Server::~Server() { }
+
+int Server::start() {
+    return m_impl->start();
+}
+
+void Server::stop() {
+    m_impl->stop();
+}
+
+bool Server::isRunning() const {
+    return m_impl->m_running;
+}
+
+const std::string& Server::getName() const {
+    return m_impl->m_name;
+}
+
+std::size_t Server::getCommandCount() const {
+    return m_impl->m_count.load(std::memory_order_relaxed);
+}
+
+} // namespace tact
@@ -1,5 +1,7 @@
 #include "misc/SPSCQueue.h"
+#include "Tact/Recorder.hpp"
 #include <Tact/Session.hpp>
+#include <Tact/Spatializer.hpp>
 #include <cassert>
 #include "portaudio.h"
 #include "pa_asio.h"
@@ -8,12 +10,24 @@
 #include <algorithm>
 #include <functional>
 #include <thread>
+#include <mutex>
 #include <iostream>
 #include <fstream>
 #include <set>
 #include <numeric>
 #include <array>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <xmmintrin.h>
+    #define SYNTACTS_SSE
+#endif
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+#endif
+
 namespace tact {
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -25,8 +39,15 @@ namespace tact {
 
 namespace {
 
-constexpr int    QUEUE_SIZE        = 1024;
+constexpr int    QUEUE_SIZE        = 4096;
+constexpr int    PENDING_SIZE      = 4096;
+constexpr int    EVENT_QUEUE_SIZE  = 1024;
 constexpr int    FRAMES_PER_BUFFER = 0;
+constexpr int    PAGE_FLOATS       = 4096 / sizeof(float);
+constexpr int    SPATIAL_BLOCK     = 32; ///< frames between spatial gain updates (gains ramp per sample in between)
+constexpr int    VOICE_BLOCK       = 128; ///< frames of each voice rendered at a time
+constexpr int    PLAY_BAKE_SIZE    = 1 << 16; ///< longest Repeater/Reverser baked by play (~1.4 s at 48 kHz), longer ones need prepare
+constexpr int    MAX_BAKE_SIZE     = 1 << 21; ///< longest Repeater/Reverser baked by prepare (~43 s at 48 kHz, 8 MB)
 
 static std::array<double,13> STANDARD_SAMPLE_RATES = {
     8000, 9600, 11025, 12000, 16000, 22050, 24000, 32000,
@@ -35,15 +56,155 @@ static std::array<double,13> STANDARD_SAMPLE_RATES = {
 
 using namespace rigtorp;
 
+/// Enables flush-to-zero/denormals-are-zero for its lifetime and then restores the previous FPU state
+class ScopedNoDenormals {
+public:
+    ScopedNoDenormals(bool enable) : m_enabled(enable), m_state(0) {
+        if (!m_enabled)
+            return;
+#if defined(SYNTACTS_SSE)
+        m_state = _mm_getcsr();
+        _mm_setcsr(static_cast<unsigned int>(m_state) | 0x8040); // FTZ | DAZ
+#elif defined(__aarch64__)
+        asm volatile("mrs %0, fpcr" : "=r"(m_state));
+        asm volatile("msr fpcr, %0" : : "r"(m_state | (1ull << 24))); // FZ
+#endif
+    }
+    ~ScopedNoDenormals() {
+        if (!m_enabled)
+            return;
+#if defined(SYNTACTS_SSE)
+        _mm_setcsr(static_cast<unsigned int>(m_state));
+#elif defined(__aarch64__)
+        asm volatile("msr fpcr, %0" : : "r"(m_state));
+#endif
+    }
+private:
+    bool m_enabled;
+    std::uint64_t m_state;
+};
+
+/// Returns true if the real-time options can be honored on this platform
+#ifdef __linux__
+bool realTimeSupported(const RealTime&) {
+    return true;
+}
+#else
+bool realTimeSupported(const RealTime& rt) {
+    return rt.scheduling == Scheduling::Default && rt.cpus.empty() && !rt.lockMemory;
+}
+#endif
+
+/// Applies real-time scheduling and CPU affinity to the calling thread
+bool applyRealTime(const RealTime& rt) {
+    bool ok = true;
+#ifdef __linux__
+    if (rt.scheduling != Scheduling::Default) {
+        int policy = rt.scheduling == Scheduling::Fifo ? SCHED_FIFO : SCHED_RR;
+        sched_param param;
+        param.sched_priority = std::clamp(rt.priority, sched_get_priority_min(policy), sched_get_priority_max(policy));
+        ok = pthread_setschedparam(pthread_self(), policy, &param) == 0 && ok;
+    }
+    if (!rt.cpus.empty()) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (auto& cpu : rt.cpus)
+            CPU_SET(cpu, &set);
+        ok = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0 && ok;
+    }
+#endif
+    return ok;
+}
+
+#ifdef __linux__
+std::mutex g_memoryMutex;
+int g_memoryLocks = 0; ///< Sessions holding the process-wide mlockall
+
+/// Locks current and future pages of the process, shared by every Session that requests it
+bool lockMemory() {
+    std::lock_guard<std::mutex> lock(g_memoryMutex);
+    if (g_memoryLocks == 0 && mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        return false;
+    g_memoryLocks++;
+    return true;
+}
+
+/// Releases a lock from lockMemory, unlocking the process when no Session holds one
+void unlockMemory() {
+    std::lock_guard<std::mutex> lock(g_memoryMutex);
+    if (g_memoryLocks > 0 && --g_memoryLocks == 0)
+        munlockall();
+}
+#endif
+
+/// Touches every page of the sample buffers in a Signal so they aren't faulted in by the audio thread
+void prefault(const Signal& signal) {
+    recurseSignal(signal, [](const Signal& sig, int) {
+        if (sig.isType<Samples>()) {
+            auto samples = sig.getAs<Samples>();
+            volatile double sink = 0;
+            for (int i = 0; i < samples->sampleCount(); i += PAGE_FLOATS)
+                sink = sink + samples->getSample(i);
+        }
+    });
+}
+
+/// Returns true if a Signal changes slowly enough to be evaluated at a control rate (envelopes and LFOs of time)
+bool isSlow(const Signal& signal, double rate) {
+    if (signal.isType<KeyedEnvelope>() || signal.isType<ASR>() || signal.isType<ADSR>() || 
+        signal.isType<ExponentialDecay>() || signal.isType<PolyBezier>())
+        return true;
+    const Signal* x = signal.isType<Sine>() ? &signal.getAs<Sine>()->x : 
+                      signal.isType<Triangle>() ? &signal.getAs<Triangle>()->x : nullptr;
+    // at least 20 evaluations per period
+    return x && x->isType<Time>() && x->bias == 0 && std::abs(x->gain) <= TWO_PI * rate / 20;
+}
+
+/// Wraps slow operands of Sums and Products in ControlRate, following only block sampled nodes
+void inferControlRate(Signal& signal, double rate) {
+    IOperator* op = signal.isType<Sum>() ? static_cast<IOperator*>(signal.getAs<Sum>()) :
+                    signal.isType<Product>() ? static_cast<IOperator*>(signal.getAs<Product>()) : nullptr;
+    if (!op)
+        return;
+    for (Signal* operand : {&op->lhs, &op->rhs}) {
+        if (isSlow(*operand, rate))
+            *operand = ControlRate(std::move(*operand), rate);
+        else
+            inferControlRate(*operand, rate);
+    }
+    signal.refresh();
+}
+
+/// Bakes Repeaters and Reversers at the playback rate so the audio thread indexes buffers instead of re-evaluating them,
+/// and evaluates slow parts of the Signal at the control rate if enabled. Modifies the Signal in place. Baked output is
+/// exact only for on-grid delays and lengths (multiples of the sample period) at pitch 1; otherwise it is interpolated.
+/// Only Repeaters and Reversers no longer than maxBakeSize samples are baked (or kept if already baked at sampleRate).
+void prepare(Signal& signal, double sampleRate, double controlRate = 0, int maxBakeSize = PLAY_BAKE_SIZE) {
+#ifndef SYNTACTS_USE_SHARED_PTR // baking mutates the model, which shared pointers would share with the caller
+    if (sampleRate <= 0)
+        return;
+    if (controlRate > 0)
+        inferControlRate(signal, controlRate);
+    // Sequences behind a SequenceRef are shared with every copy (including voices being played), so they stay unbaked
+    recurseSignal(signal, [&](const Signal& sig, int) {
+        if (sig.isType<Repeater>())
+            sig.getAs<Repeater>()->bake(sampleRate, maxBakeSize);
+        else if (sig.isType<Reverser>())
+            sig.getAs<Reverser>()->bake(sampleRate, maxBakeSize);
+    }, false);
+#endif
+}
+
 struct Voice {
     Signal signal;
     double time  = 0;
     bool stopped = true;
-    inline double step(double dt) {
-        double s = signal.sample(time) * (!stopped);
-        time += dt;
-        return s;
-    }    
+};
+
+/// Channel state flags published to caller threads
+enum ChannelState : int {
+    ChannelPlaying = 1,
+    ChannelPaused  = 2
 };
 
 /// Channel structure
@@ -54,11 +215,19 @@ public:
     double  sampleLength = 0.0;
     double  volume       = 1.0;
     double  pitch        = 1.0;
+    double  spatial      = 1.0;     ///< gain set by spatial panners
     double  level        = 0.0;
     bool    paused       = false;
     bool    stopped      = true;
+    int     index        = 0;       ///< channel index reported in events
+    double  time         = 0.0;     ///< Session time elapsed on this channel
+    SPSCQueue<Event>* events = nullptr;
+    std::atomic<std::uint64_t>* droppedEvents = nullptr; ///< voice events that didn't fit in events
+    bool    idlePending  = false;   ///< ChannelIdle couldn't be queued and is retried each buffer
+    double  idleTime     = 0.0;
    
     void fillBuffer(float* buffer, unsigned long frames) {
+        retryIdle();
         // interp volume
         double nextVolume = volume;
         double volumeIncr = (nextVolume - lastVolume) / frames;
@@ -67,6 +236,9 @@ public:
         double nextPitch = pitch;
         double pitchIncr = (nextPitch - lastPitch) / frames;
         pitch = lastPitch;
+        // interp spatial gain
+        double spatialIncr = (spatial - lastSpatial) / frames;
+        double gain = lastSpatial;
 
         if (paused || stopped) {
             for (unsigned long f = 0; f < frames; ++f) {
@@ -77,59 +249,126 @@ public:
         else {
             // fill buffer
             double max_level = 0;
-            for (unsigned long f = 0; f < frames; ++f) {
-                pitch += pitchIncr;
-                volume += volumeIncr;
-                double dt = sampleLength * pitch;
-                double output = stepVoices(dt) * volume;
-                double abs_out = std::abs(output);
-                max_level = abs_out > max_level ? abs_out : max_level;
-                buffer[f] = static_cast<float>(output);
+            double offset[VOICE_BLOCK], mix[VOICE_BLOCK];
+            for (unsigned long f0 = 0; f0 < frames; f0 += VOICE_BLOCK) {
+                int n = static_cast<int>(std::min<unsigned long>(VOICE_BLOCK, frames - f0));
+                // voice time of each frame relative to the first, following the pitch ramp
+                double elapsed = 0;
+                for (int i = 0; i < n; ++i) {
+                    pitch += pitchIncr;
+                    offset[i] = elapsed;
+                    elapsed += sampleLength * pitch;
+                }
+                mixVoices(offset, elapsed, n, mix);
+                for (int i = 0; i < n; ++i) {
+                    volume += volumeIncr;
+                    gain += spatialIncr;
+                    double output = mix[i] * volume * gain;
+                    double abs_out = std::abs(output);
+                    max_level = abs_out > max_level ? abs_out : max_level;
+                    buffer[f0 + i] = static_cast<float>(output);
+                }
             }
             level = max_level; // sum_output / frames;
         }
+        time += frames * sampleLength;
+        bool wasStopped = stopped;
         stopped = activeVoices() == 0;
+        if (stopped && !wasStopped)
+            emitIdle();
         volume     = nextVolume;
         lastVolume = nextVolume;
         pitch      = nextPitch;
         lastPitch  = nextPitch;
+        lastSpatial = spatial;
     }
 
     inline void play(Signal sig) {
         stopped = false;
         paused = false;
-        for (auto& v : voices) {
+        for (int i = 0; i < SYNTACTS_MAX_VOICES; ++i) {
+            auto& v = voices[i];
             if (v.stopped) {
                 v.signal = std::move(sig);
                 v.stopped = false;
                 v.time = 0;
+                emit(Event::VoiceStarted, i);
                 return;
             }
         }
+        emit(Event::VoiceStolen, 0);
         voices[0].signal  = std::move(sig);
         voices[0].stopped = false;
         voices[0].time    = 0;
+        emit(Event::VoiceStarted, 0);
     }
 
     inline void stop() {
-        for (auto& v : voices) {
+        bool wasStopped = stopped;
+        for (int i = 0; i < SYNTACTS_MAX_VOICES; ++i) {
+            auto& v = voices[i];
+            if (!v.stopped)
+                emit(Event::VoiceFinished, i);
             v.stopped = true;
             v.time   = 0;
         }
+        stopped = true;
         paused = true;
+        if (!wasStopped)
+            emitIdle();
+    }
+
+    inline int state() const {
+        return (!paused && !stopped ? ChannelPlaying : 0) | (paused ? ChannelPaused : 0);
+    }
+
+    /// Emits a voice event, counting it as dropped if the event queue is full
+    inline void emit(Event::Type type, int voice) {
+        if (events && !events->try_push(Event{type, index, voice, time}))
+            droppedEvents->fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// Emits ChannelIdle, deferring it to later buffers if the event queue is full so the idle state is never lost
+    inline void emitIdle() {
+        idleTime    = time;
+        idlePending = events && !events->try_push(Event{Event::ChannelIdle, index, -1, idleTime});
+    }
+
+    /// Retries a deferred ChannelIdle, discarding it if the channel has since become active again
+    inline void retryIdle() {
+        if (idlePending && stopped)
+            idlePending = !events->try_push(Event{Event::ChannelIdle, index, -1, idleTime});
+        else
+            idlePending = false;
     }
 
-    inline double stepVoices(double dt) {
-        double sum = 0;
-        for (auto& v : voices)
-            sum += v.step(dt);
-        return sum;
+    /// Sums playing voices at frame offsets from their times into mix as blocks, then advances them by elapsed.
+    /// Voices silent for the whole block (e.g. past the end of an envelope) aren't sampled.
+    inline void mixVoices(const double* offset, double elapsed, int n, double* mix) {
+        double t[VOICE_BLOCK], b[VOICE_BLOCK];
+        std::fill(mix, mix + n, 0.0);
+        for (auto& v : voices) {
+            if (v.stopped)
+                continue;
+            for (int i = 0; i < n; ++i)
+                t[i] = v.time + offset[i];
+            auto span = std::minmax_element(t, t + n);
+            if (!v.signal.silent(*span.first, *span.second)) {
+                v.signal.sample(t, b, n);
+                for (int i = 0; i < n; ++i)
+                    mix[i] += b[i];
+            }
+            v.time += elapsed;
+        }
     }
 
     inline int activeVoices() {
         int count = 0;
-        for (auto& v : voices) {
+        for (int i = 0; i < SYNTACTS_MAX_VOICES; ++i) {
+            auto& v = voices[i];
             if (v.time > v.signal.length()) {
+                if (!v.stopped)
+                    emit(Event::VoiceFinished, i);
                 v.stopped = true;
                 v.time    = 0;
             }
@@ -143,17 +382,329 @@ public:
 private:
     double  lastVolume   = 1.0;
     double  lastPitch    = 1.0;
+    double  lastSpatial  = 1.0;
+};
+
+/// Returns the difference p1 - p2 wrapped into [-interval/2, interval/2)
+inline double wrappedDifference(double p1, double p2, double interval) { 
+    return p1 - p2 - std::floor(((p1 - p2) + interval * 0.5) / interval) * interval;
+}
+
+/// Panning parameters interpolated for one control block
+struct PanParams {
+    PanParams(const Panning& from, const Panning& to, double f) :
+        x(lerp(from.x, to.x, f)),
+        y(lerp(from.y, to.y, f)),
+        z(lerp(from.z, to.z, f)),
+        radius(lerp(from.radius, to.radius, f)),
+        volume(lerp(from.volume, to.volume, f)),
+        invRadius(radius > 0 ? 1.0 / radius : 0),
+        kernelX(to.kernelX), kernelY(to.kernelY), kernelZ(to.kernelZ),
+        wrapX(to.wrapX),
+        wrapY(to.wrapY),
+        rollOff(to.rollOff),
+        nearest(to.nearest)
+    { }
+    double x, y, z, radius, volume, invRadius, kernelX, kernelY, kernelZ, wrapX, wrapY;
+    const Curve& rollOff;
+    int nearest;
+};
+
+/// Target motion evaluated by the audio thread
+struct Motion {
+    std::unique_ptr<Trajectory> trajectory; ///< null if the target isn't moving
+    double time = 0;          ///< time since the motion started
+    double x = 0, y = 0, radius = 0; ///< most recently evaluated parameters
+
+    /// Advances the motion by a control block and overrides interpolated parameters with the trajectory (z is unchanged)
+    void step(PanParams& p, double dt) {
+        time += dt;
+        x = p.x = trajectory->x.sample(time);
+        y = p.y = trajectory->y.sample(time);
+        if (trajectory->hasRadius) {
+            radius = p.radius = std::max(0.0, trajectory->radius.sample(time));
+            p.invRadius = radius > 0 ? 1.0 / radius : 0;
+        }
+        else
+            radius = p.radius;
+    }
+
+    /// Stops the motion, leaving the Panning to continue from where the trajectory left it
+    void stop(Panning& current, std::unique_ptr<Trajectory>& out) {
+        if (trajectory) {
+            current.x = x;
+            current.y = y;
+            current.radius = radius;
+        }
+        std::swap(trajectory, out);
+    }
+};
+
+/// Adds a source block to a channel buffer with a gain ramped linearly from g0 to g1, tracking the channel level
+inline void mixInto(float* out, const float* source, int frames, float g0, float g1, double& level) {
+    if (g0 == 0 && g1 == 0)
+        return;
+    float step = (g1 - g0) / frames;
+    float peak = 0;
+    for (int i = 0; i < frames; ++i) {
+        out[i] += (g0 + step * (i + 1)) * source[i];
+        peak = std::max(peak, std::abs(out[i]));
+    }
+    level = std::max(level, static_cast<double>(peak));
+}
+
+/// Per-channel gains of a spatial source, allocated off the audio thread
+struct SourceGains {
+    std::vector<float> gains; ///< gain of each panner channel at the end of the last block
+    std::vector<int> active;  ///< channels that may have nonzero gain
+    std::vector<int> nearby;  ///< scratch for channels near the source (capacity reserved for all)
+};
+
+/// Signal mixed into the channels of a panner at its own position
+struct Source {
+    bool playing = false;
+    bool primed  = false;     ///< true once parameters have been received
+    Signal signal;
+    double time = 0;
+    Panning current;
+    Panning target;
+    Motion motion;
+    SourceGains state;
+};
+
+/// Channels of a panner and the buffers evaluating them, built off the audio thread
+struct PannerLayout {
+    /// Builds the layout and reserves every buffer the audio thread will need
+    void build(const std::vector<int>& chs, const std::vector<double>& x, const std::vector<double>& y, 
+               const std::vector<double>& z, const std::vector<double>& gains) 
+    {
+        std::size_t n = chs.size();
+        channels = chs;
+        calibration = gains;
+        index.build(x, y, z);
+        // every channel starts active so the first update silences those outside the radius
+        active.resize(n);
+        std::iota(active.begin(), active.end(), 0);
+        nearby.reserve(n);
+        order.reserve(n);
+        distance.resize(n);
+        gain.resize(n);
+        for (auto& source : sources) {
+            source.gains.assign(n, 0);
+            source.active.reserve(n);
+            source.nearby.reserve(n);
+        }
+    }
+
+    std::vector<int> channels;
+    SpatialIndex index;             ///< channel positions
+    std::vector<double> calibration; ///< gain of each channel
+    std::vector<int> active;        ///< positions given gains by the last target update
+    std::vector<int> nearby;        ///< scratch for positions near the target
+    std::vector<int> order;         ///< scratch for selecting nearest positions
+    std::vector<double> distance;   ///< scratch for distances to the nearest positions
+    std::vector<double> gain;       ///< scratch for gains of the nearest positions
+    std::array<SourceGains, SYNTACTS_MAX_SOURCES> sources;
+};
+
+/// Spatial panner state owned by the audio thread
+struct Panner {
+    bool primed = false;      ///< true once parameters have been received
+    PannerLayout layout;
+    Panning current;          ///< parameters at the end of the last rendered segment
+    Panning target;           ///< most recently received parameters
+    Motion motion;            ///< trajectory overriding the target position
+    std::array<Source, SYNTACTS_MAX_SOURCES> sources;
+
+    /// Returns true if the panner has channels and anything to evaluate
+    bool busy() const {
+        if (layout.channels.empty())
+            return false;
+        if (primed)
+            return true;
+        for (auto& s : sources) {
+            if (s.playing && s.primed)
+                return true;
+        }
+        return false;
+    }
+
+    /// Finds positions whose gain may be nonzero, and evaluates their gains into layout.gain if they are the nearest positions
+    void evaluate(const PanParams& p, std::vector<int>& out) {
+        auto& index = layout.index;
+        // nearest positions and roll-offs audible beyond the radius need every position
+        if (p.nearest > 0 || p.rollOff(0) * p.volume != 0)
+            index.queryAll(out);
+        else
+            index.query(p.x, p.y, p.z, p.radius * p.kernelX, p.radius * p.kernelY, p.radius * p.kernelZ, p.wrapX, p.wrapY, out);
+        if (p.nearest == 0)
+            return;
+        int m = static_cast<int>(out.size());
+        double* d = layout.distance.data();
+        for (int i = 0; i < m; ++i)
+            d[i] = distance(out[i], p);
+        nearest(p, out, m);
+    }
+
+    /// Returns the distance from the target to position k scaled by the kernel, so the radius becomes an ellipsoid
+    double distance(int k, const PanParams& p) const {
+        auto& index = layout.index;
+        double dx = (p.wrapX > 0 ? wrappedDifference(index.x(k), p.x, p.wrapX) : index.x(k) - p.x) / p.kernelX;
+        double dy = (p.wrapY > 0 ? wrappedDifference(index.y(k), p.y, p.wrapY) : index.y(k) - p.y) / p.kernelY;
+        double dz = (index.z(k) - p.z) / p.kernelZ;
+        return std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    /// Returns the gain of the i-th evaluated position k, from layout.gain for nearest positions or else the radius and roll-off
+    double gain(int i, int k, const PanParams& p) const {
+        if (p.nearest > 0)
+            return layout.gain[i];
+        double g = p.radius > 0 ? 1.0 - clamp01(distance(k, p) * p.invRadius) : 0;
+        return p.rollOff(g) * p.volume * layout.calibration[k];
+    }
+
+    /// Gives the nearest positions inverse distance gains normalized to constant power (as VBAP does), and the rest zero
+    void nearest(const PanParams& p, const std::vector<int>& out, int m) {
+        double* d = layout.distance.data();
+        double* g = layout.gain.data();
+        auto& order = layout.order;
+        int q = std::min(p.nearest, m);
+        order.resize(m);
+        std::iota(order.begin(), order.end(), 0);
+        if (q < m)
+            std::nth_element(order.begin(), order.begin() + q, order.end(), [d](int a, int b) { return d[a] < d[b]; });
+        std::fill(g, g + m, 0.0);
+        double power = 0;
+        for (int j = 0; j < q; ++j) {
+            double w = 1.0 / std::max(d[order[j]], 1e-6);
+            g[order[j]] = w;
+            power += w * w;
+        }
+        double norm = power > 0 ? p.volume / std::sqrt(power) : 0;
+        for (int j = 0; j < q; ++j)
+            g[order[j]] *= norm * layout.calibration[out[order[j]]];
+    }
+
+    /// Sets the spatial gain of channels for parameters interpolated a fraction f through the segment
+    void apply(std::vector<Channel>& chs, int frames, double f) {
+        if (!primed)
+            return;
+        PanParams p(current, target, f);
+        if (motion.trajectory)
+            motion.step(p, frames * chs[0].sampleLength);
+        auto& nearby = layout.nearby;
+        evaluate(p, nearby);
+        for (std::size_t i = 0; i < nearby.size(); ++i) {
+            int ch = layout.channels[nearby[i]];
+            if (ch < static_cast<int>(chs.size()))
+                chs[ch].spatial = gain(static_cast<int>(i), nearby[i], p);
+        }
+        // silence channels that just left the radius
+        for (auto& k : layout.active) {
+            int ch = layout.channels[k];
+            if (!layout.index.queried(k) && ch < static_cast<int>(chs.size()))
+                chs[ch].spatial = 0;
+        }
+        std::swap(layout.active, nearby);
+    }
+
+    /// Renders playing sources and adds them to channel buffers for a control block
+    void mix(std::vector<Channel>& chs, float** out, unsigned long offset, int frames, double f) {
+        for (auto& s : sources) {
+            if (s.playing && s.primed)
+                mixSource(s, chs, out, offset, frames, f);
+        }
+    }
+
+    /// Renders one source once and adds it to the channels near it
+    void mixSource(Source& s, std::vector<Channel>& chs, float** out, unsigned long offset, int frames, double f) {
+        double dt = chs[0].sampleLength;
+        double t[SPATIAL_BLOCK], b[SPATIAL_BLOCK];
+        float block[SPATIAL_BLOCK];
+        for (int i = 0; i < frames; ++i)
+            t[i] = s.time + i * dt;
+        s.signal.sample(t, b, frames);
+        for (int i = 0; i < frames; ++i)
+            block[i] = static_cast<float>(b[i]);
+        s.time += frames * dt;
+        auto& st = s.state;
+        PanParams p(s.current, s.target, f);
+        if (s.motion.trajectory)
+            s.motion.step(p, frames * dt);
+        evaluate(p, st.nearby);
+        for (std::size_t i = 0; i < st.nearby.size(); ++i) {
+            int k  = st.nearby[i];
+            int ch = layout.channels[k];
+            if (ch >= static_cast<int>(chs.size()))
+                continue;
+            float g = static_cast<float>(gain(static_cast<int>(i), k, p) * chs[ch].volume);
+            mixInto(out[ch] + offset, block, frames, st.gains[k], g, chs[ch].level);
+            st.gains[k] = g;
+        }
+        // fade out channels that just left the radius
+        for (auto& k : st.active) {
+            int ch = layout.channels[k];
+            if (layout.index.queried(k) || ch >= static_cast<int>(chs.size()))
+                continue;
+            mixInto(out[ch] + offset, block, frames, st.gains[k], 0, chs[ch].level);
+            st.gains[k] = 0;
+        }
+        std::swap(st.active, st.nearby);
+        if (s.time > s.signal.length())
+            stop(s);
+    }
+
+    /// Stops a source and clears its gains
+    void stop(Source& s) {
+        for (auto& k : s.state.active)
+            s.state.gains[k] = 0;
+        s.state.active.clear();
+        s.playing = false;
+    }
+
+    /// Completes panner and source motion at the end of a segment
+    void settle() {
+        settle(current, target);
+        for (auto& s : sources)
+            settle(s.current, s.target);
+    }
+
+    static void settle(Panning& current, const Panning& target) {
+        current.x      = target.x;
+        current.y      = target.y;
+        current.z      = target.z;
+        current.radius = target.radius;
+        current.volume = target.volume;
+    }
+
+    /// Restores unit spatial gain on the panner's channels
+    void release(std::vector<Channel>& chs) const {
+        for (auto& ch : layout.channels) {
+            if (ch < static_cast<int>(chs.size()))
+                chs[ch].spatial = 1.0;
+        }
+    }
+
+    /// Swaps in a layout built by another thread, leaving the old layout and source gains in other to be freed by it
+    void swap(PannerLayout& other) {
+        std::swap(layout, other);
+        for (int i = 0; i < SYNTACTS_MAX_SOURCES; ++i) {
+            std::swap(sources[i].state, layout.sources[i]);
+            std::swap(layout.sources[i], other.sources[i]);
+        }
+    }
 };
 
 /// Interface for commands sent through command queue
 struct Command {
     int channel;
+    std::int64_t frame = -1; ///< Session frame to perform at (-1 for the start of the next buffer)
     std::atomic_flag flag = ATOMIC_FLAG_INIT;
 
     Command() { flag.test_and_set(std::memory_order_acquire); }
 
-    void perform(Channel& channel) {
-        performImpl(channel);
+    void perform(std::vector<Channel>& channels) {
+        performOn(channels);
         flag.clear(std::memory_order_release);
     }
 
@@ -162,7 +713,12 @@ struct Command {
         }
     }
 
-    virtual void performImpl(Channel& channel) = 0;
+    /// Performs the command on its channel (commands that don't target one channel override this)
+    virtual void performOn(std::vector<Channel>& channels) {
+        performImpl(channels[channel]);
+    }
+
+    virtual void performImpl(Channel& channel) { }
 };
 
 struct Play : public Command {
@@ -220,6 +776,102 @@ struct GetLevel : public Command {
     double level;
 };
 
+struct SetPannerChannels : public Command {
+    virtual void performOn(std::vector<Channel>& channels) override {
+        panner->release(channels);
+        // swap so the old buffers leave with the command, which is retired to the calling thread to be freed
+        panner->swap(layout);
+    }
+    Panner* panner;
+    PannerLayout layout;
+};
+
+struct SetPanning : public Command {
+    virtual void performOn(std::vector<Channel>& channels) override {
+        if (!panner->primed)
+            Panner::settle(panner->current, panning);
+        panner->target = std::move(panning);
+        panner->primed = true;
+    }
+    Panner* panner;
+    Panning panning;
+};
+
+struct ClosePanner : public Command {
+    virtual void performOn(std::vector<Channel>& channels) override {
+        panner->release(channels);
+        panner->swap(layout);
+        panner->primed = false;
+        panner->motion.stop(panner->current, trajectories[0]);
+        for (int i = 0; i < SYNTACTS_MAX_SOURCES; ++i) {
+            auto& s = panner->sources[i];
+            s.playing = false;
+            s.primed  = false;
+            s.motion.stop(s.current, trajectories[i + 1]);
+        }
+    }
+    Panner* panner;
+    PannerLayout layout;
+    std::array<std::unique_ptr<Trajectory>, SYNTACTS_MAX_SOURCES + 1> trajectories;
+};
+
+struct PlaySource : public Command {
+    virtual void performOn(std::vector<Channel>& channels) override {
+        auto& s = panner->sources[source];
+        std::swap(s.signal, signal);
+        s.time    = 0;
+        s.playing = true;
+    }
+    Panner* panner;
+    int source;
+    Signal signal;
+};
+
+struct StopSource : public Command {
+    virtual void performOn(std::vector<Channel>& channels) override {
+        panner->stop(panner->sources[source]);
+    }
+    Panner* panner;
+    int source;
+};
+
+struct SetTrajectory : public Command {
+    virtual void performOn(std::vector<Channel>& channels) override {
+        auto& motion = source < 0 ? panner->motion : panner->sources[source].motion;
+        // swap so the previous trajectory leaves with the command, which is retired to the calling thread to be freed
+        std::swap(motion.trajectory, trajectory);
+        motion.time = 0;
+    }
+    Panner* panner;
+    int source;    ///< source index, or -1 for the panner target
+    std::unique_ptr<Trajectory> trajectory;
+};
+
+struct ClearTrajectory : public Command {
+    virtual void performOn(std::vector<Channel>& channels) override {
+        if (source < 0)
+            panner->motion.stop(panner->current, trajectory);
+        else
+            panner->sources[source].motion.stop(panner->sources[source].current, trajectory);
+    }
+    Panner* panner;
+    int source;    ///< source index, or -1 for the panner target
+    std::unique_ptr<Trajectory> trajectory;
+};
+
+struct SetSourcePanning : public Command {
+    virtual void performOn(std::vector<Channel>& channels) override {
+        auto& s = panner->sources[source];
+        if (!s.primed)
+            Panner::settle(s.current, panning);
+        s.target = std::move(panning);
+        s.primed = true;
+    }
+    Panner* panner;
+    int source;
+    Panning panning;
+};
+
 } // private namespace
 
 Device::Device() :
@@ -234,6 +886,29 @@ Device::Device() :
     defaultSampleRate(0)
 { }
 
+Trajectory::Trajectory() :
+    hasRadius(false)
+{ }
+
+Panning::Panning() :
+    x(0.5), y(0.5), z(0),
+    radius(0.25),
+    kernelX(1), kernelY(1), kernelZ(1),
+    volume(1),
+    wrapX(0), wrapY(0),
+    rollOff(Curves::Linear()),
+    nearest(0)
+{ }
+
+RealTime::RealTime() :
+    scheduling(Scheduling::Default),
+    priority(80),
+    cpus({}),
+    flushDenormals(true),
+    lockMemory(false),
+    controlRate(0)
+{ }
+
 /// Session Implementation
 class Session::Impl {
 public:
@@ -241,6 +916,8 @@ public:
     Impl() :
         m_stream(nullptr),
         m_commands(QUEUE_SIZE),
+        m_retired(QUEUE_SIZE + PENDING_SIZE),
+        m_events(EVENT_QUEUE_SIZE),
         m_device()
     {
 
@@ -261,6 +938,7 @@ public:
     }
 
     ~Impl() {
+        setEventCallback(nullptr);
         if (isOpen())
             close();
         int result = Pa_Terminate();
@@ -301,16 +979,48 @@ public:
         // resize vector of channels
         m_channels.clear();
         m_channels.resize(channels);
-        for (auto& c : m_channels) 
-            c.sampleLength = 1.0 / sampleRate;
+        m_states = std::make_unique<std::atomic<int>[]>(channels);
+        for (int i = 0; i < channels; ++i) {
+            m_channels[i].sampleLength = 1.0 / sampleRate;
+            m_channels[i].index = i;
+            m_channels[i].events = &m_events;
+            m_channels[i].droppedEvents = &m_droppedEvents;
+            m_states[i] = 0;
+        }
+        // lock current and future pages so the audio thread never faults
+#ifdef __linux__
+        m_memoryLocked = m_realTime.lockMemory && lockMemory();
+        if (m_realTime.lockMemory && !m_memoryLocked)
+            std::cout << "Failed to lock Session memory (check RLIMIT_MEMLOCK)" << std::endl;
+#endif
+        m_rtState = RealTimePending;
+        m_pending.clear();
+        m_pending.reserve(PENDING_SIZE);
+        m_frame = 0;
+        m_droppedEvents = 0;
         // open stream
         int result;
         result = Pa_OpenStream(&m_stream, nullptr, &params, sampleRate, FRAMES_PER_BUFFER, paNoFlag, callback, this);
-        if (result != paNoError)
+        if (result != paNoError) {
+            m_stream = nullptr;
+            releaseMemory();
             return result;  
+        }
         result = Pa_StartStream(m_stream);
-        if (result != paNoError)
+        if (result != paNoError) {
+            // the stream never became active, so close() would report NotOpen and never release it
+            Pa_CloseStream(m_stream);
+            m_stream = nullptr;
+            releaseMemory();
             return result;
+        }
+        // the audio thread applies its options on the first callback, so wait briefly to report failures
+        if (m_realTime.scheduling != Scheduling::Default || !m_realTime.cpus.empty()) {
+            for (int i = 0; i < 100 && m_rtState == RealTimePending; ++i)
+                sleep(0.005);
+            if (m_rtState == RealTimeFailed)
+                std::cout << "Failed to apply real-time options to the audio thread (check RLIMIT_RTPRIO)" << std::endl;
+        }
         // set device/sampel rate
         m_device = device;
         m_sampleRate = sampleRate;
@@ -324,51 +1034,175 @@ public:
         if (result != paNoError) {
             return result;
         }
+        m_stream = nullptr;
+        stopRecording();
         m_device = Device();
+        m_pending.clear();
+        freeRetired();
         m_channels.clear();
         m_sampleRate = 0;
-        m_stream = nullptr;
+        releaseMemory();
+        return SyntactsError_NoError;
+    }
+
+    /// Releases this Session's memory lock, if it holds one
+    void releaseMemory() {
+#ifdef __linux__
+        if (m_memoryLocked)
+            unlockMemory();
+        m_memoryLocked = false;
+#endif
+    }
+
+    int setRealTime(const RealTime& options) {
+        if (isOpen())
+            return SyntactsError_AlreadyOpen;
+        if (!realTimeSupported(options))
+            return SyntactsError_NotSupported;
+        m_realTime = options;
         return SyntactsError_NoError;
     }
 
+    const RealTime& getRealTime() const {
+        return m_realTime;
+    }
+
+    int startRecording(const std::string& filePath) {
+        if (!isOpen())
+            return SyntactsError_NotOpen;
+        if (m_recorder)
+            return SyntactsError_AlreadyRecording;
+        auto recorder = std::make_unique<Recorder>();
+        if (!recorder->open(filePath, (int)m_channels.size(), m_sampleRate))
+            return SyntactsError_FileError;
+        m_recorder = std::move(recorder);
+        m_recording.store(m_recorder.get(), std::memory_order_release);
+        return SyntactsError_NoError;
+    }
+
+    int stopRecording() {
+        if (!m_recorder)
+            return SyntactsError_NoError;
+        m_recording.store(nullptr, std::memory_order_release);
+        // wait for a callback that may still hold the recorder to finish
+        if (isOpen()) {
+            std::uint64_t frame = m_frame.load(std::memory_order_acquire);
+            for (int i = 0; i < 1000 && m_frame.load(std::memory_order_acquire) == frame; ++i)
+                sleep(0.001);
+        }
+        bool written = m_recorder->close();
+        if (auto dropped = m_recorder->getDroppedFrames())
+            std::cout << "Recording dropped " << dropped << " frames" << std::endl;
+        m_recorder.reset();
+        return written ? SyntactsError_NoError : SyntactsError_FileError;
+    }
+
+    bool isRecording() const {
+        return m_recorder != nullptr;
+    }
+
     bool isOpen() const {
         return m_stream != nullptr && Pa_IsStreamActive(m_stream) == 1;
     }
 
     bool isPlaying(int channel) {
-        return !m_channels[channel].paused && !m_channels[channel].stopped; 
+        if (!isOpen() || !(channel < m_channels.size()))
+            return false;
+        return m_states[channel] & ChannelPlaying;
     }
 
     bool isPaused(int channel) {
-        return m_channels[channel].paused; 
+        if (!isOpen() || !(channel < m_channels.size()))
+            return false;
+        return m_states[channel] & ChannelPaused;
+    }
+
+    bool pollEvent(Event& event) {
+        if (m_dispatching)
+            return false;
+        std::lock_guard<std::mutex> lock(m_eventMutex);
+        if (!m_events.front())
+            return false;
+        event = *m_events.front();
+        m_events.pop();
+        return true;
+    }
+
+    std::uint64_t getDroppedEvents() const {
+        return m_droppedEvents.load(std::memory_order_relaxed);
+    }
+
+    void setEventCallback(std::function<void(const Event&)> callback) {
+        if (m_eventThread.joinable()) {
+            m_dispatching = false;
+            m_eventThread.join();
+        }
+        std::lock_guard<std::mutex> lock(m_eventMutex);
+        m_eventCallback = std::move(callback);
+        if (m_eventCallback) {
+            m_dispatching = true;
+            m_eventThread = std::thread(&Impl::dispatchEvents, this);
+        }
+    }
+
+    void dispatchEvents() {
+        while (m_dispatching) {
+            {
+                std::lock_guard<std::mutex> lock(m_eventMutex);
+                while (m_events.front()) {
+                    Event event = *m_events.front();
+                    m_events.pop();
+                    m_eventCallback(event);
+                }
+            }
+            sleep(0.001);
+        }
+    }
+
+    /// Converts a Session time to the frame a command is performed at
+    std::int64_t toFrame(double time) const {
+        return time < 0 ? -1 : static_cast<std::int64_t>(std::llround(time * m_sampleRate));
+    }
+
+    double getTime() const {
+        if (m_sampleRate == 0)
+            return 0;
+        return m_frame.load(std::memory_order_relaxed) / m_sampleRate;
     }
 
-    int play(int channel, Signal signal) {
+    /// Queues a command for the audio thread, failing rather than blocking if the queue is full
+    int push(std::shared_ptr<Command> command) {
+        freeRetired();
+        return m_commands.try_push(std::move(command)) ? SyntactsError_NoError : SyntactsError_QueueFull;
+    }
+
+    int play(int channel, Signal signal, double time = -1) {
         if (!isOpen())
             return SyntactsError_NotOpen;
         if (!(channel < m_channels.size()))
             return SyntactsError_InvalidChannel;
+        tact::prepare(signal, m_sampleRate, m_realTime.controlRate);
+        if (m_realTime.lockMemory)
+            prefault(signal);
         auto command = std::make_shared<Play>();
         command->signal = std::move(signal);
         command->channel = channel;
-        bool success = m_commands.try_push(std::move(command));
-        assert(success);
-        return SyntactsError_NoError;
+        command->frame = toFrame(time);
+        return push(std::move(command));
     }
 
-    int stop(int channel) {
+    int stop(int channel, double time = -1) {
         if (!isOpen())
             return SyntactsError_NotOpen;
         if (!(channel < m_channels.size()))
             return SyntactsError_InvalidChannel;
         auto command = std::make_shared<Stop>();
         command->channel = channel;   
-        bool success = m_commands.try_push(std::move(command));
-        assert(success);
-        return SyntactsError_NoError;     
+        command->frame = toFrame(time);
+        return push(std::move(command));
     }
 
-    int pause(int channel, bool paused) {
+    int pause(int channel, bool paused, double time = -1) {
         if (!isOpen())
             return SyntactsError_NotOpen;
         if (!(channel < m_channels.size()))
@@ -376,19 +1210,20 @@ public:
         auto command = std::make_shared<SetPause>();
         command->channel = channel;   
         command->paused  = paused;
-        bool success = m_commands.try_push(std::move(command));
-        assert(success);
-        return SyntactsError_NoError;       
+        command->frame   = toFrame(time);
+        return push(std::move(command));
     }
 
-    int setVolume(int channel, double volume) {
-        
+    int setVolume(int channel, double volume, double time = -1) {
+        if (!isOpen())
+            return SyntactsError_NotOpen;
+        if (!(channel < m_channels.size()))
+            return SyntactsError_InvalidChannel;
         auto command = std::make_shared<SetVolume>();
         command->channel = channel;
         command->volume  = clamp01(volume);
-        bool success = m_commands.try_push(std::move(command));
-        assert(success);
-        return SyntactsError_NoError; 
+        command->frame   = toFrame(time);
+        return push(std::move(command));
     }
 
     double getVolume(int channel) {
@@ -400,13 +1235,13 @@ public:
             return m_channels[channel].volume; // this *should* be thread safe, TBD
         else {
             auto command = std::make_shared<GetVolume>();
-            bool success = m_commands.try_push(std::move(command));
-            assert(success);
+            if (push(command) != SyntactsError_NoError)
+                return 0;
             return command->volume;
         } 
     }
 
-    int setPitch(int channel, double pitch) {
+    int setPitch(int channel, double pitch, double time = -1) {
         if (!isOpen())
             return SyntactsError_NotOpen;
         if (!(channel < m_channels.size()))
@@ -414,9 +1249,8 @@ public:
         auto command = std::make_shared<SetPitch>();
         command->channel = channel;
         command->pitch   = pitch;
-        bool success = m_commands.try_push(std::move(command));
-        assert(success);
-        return SyntactsError_NoError;       
+        command->frame   = toFrame(time);
+        return push(std::move(command));
     }
 
     double getPitch(int channel) {
@@ -428,8 +1262,8 @@ public:
             return m_channels[channel].pitch;
         else {
             auto command = std::make_shared<GetPitch>();
-            bool success = m_commands.try_push(std::move(command));
-            assert(success);
+            if (push(command) != SyntactsError_NoError)
+                return 1;
             return command->pitch;
         } 
     }
@@ -443,12 +1277,196 @@ public:
             return m_channels[channel].level;
         else {        
             auto command = std::make_shared<GetLevel>();
-            bool success = m_commands.try_push(std::move(command));
-            assert(success);
+            if (push(command) != SyntactsError_NoError)
+                return 0;
             return command->level;
         }
     }
 
+    int openPanner() {
+        for (int i = 0; i < SYNTACTS_MAX_PANNERS; ++i) {
+            if (!m_pannerOpen[i]) {
+                m_pannerOpen[i] = true;
+                return i;
+            }
+        }
+        return SyntactsError_InvalidPanner;
+    }
+
+    int closePanner(int panner) {
+        if (!validPanner(panner))
+            return SyntactsError_InvalidPanner;
+        m_pannerOpen[panner] = false;
+        if (!isOpen()) {
+            m_panners[panner] = Panner();
+            return SyntactsError_NoError;
+        }
+        auto command = std::make_shared<ClosePanner>();
+        command->panner = &m_panners[panner];
+        return push(std::move(command));
+    }
+
+    int setPannerChannels(int panner, const std::vector<int>& channels, const std::vector<double>& x, const std::vector<double>& y, 
+                          const std::vector<double>& z, const std::vector<double>& gains) 
+    {
+        if (!isOpen())
+            return SyntactsError_NotOpen;
+        if (!validPanner(panner))
+            return SyntactsError_InvalidPanner;
+        std::size_t n = channels.size();
+        if (x.size() != n || y.size() != n || (!z.empty() && z.size() != n) || (!gains.empty() && gains.size() != n))
+            return SyntactsError_InvalidChannel;
+        for (auto& ch : channels) {
+            if (ch < 0 || !(ch < m_channels.size()))
+                return SyntactsError_InvalidChannel;
+        }
+        auto command = std::make_shared<SetPannerChannels>();
+        command->panner = &m_panners[panner];
+        command->layout.build(channels, x, y, z, gains.empty() ? std::vector<double>(n, 1.0) : gains);
+        return push(std::move(command));
+    }
+
+    /// Clamps Panning parameters to their valid ranges
+    static Panning sanitize(const Panning& panning) {
+        Panning out = panning;
+        out.radius  = std::max(0.0, panning.radius);
+        out.volume  = clamp01(panning.volume);
+        out.kernelX = panning.kernelX > 0 ? panning.kernelX : 1;
+        out.kernelY = panning.kernelY > 0 ? panning.kernelY : 1;
+        out.kernelZ = panning.kernelZ > 0 ? panning.kernelZ : 1;
+        out.nearest = std::max(0, panning.nearest);
+        return out;
+    }
+
+    int setPanning(int panner, const Panning& panning, double time = -1) {
+        if (!isOpen())
+            return SyntactsError_NotOpen;
+        if (!validPanner(panner))
+            return SyntactsError_InvalidPanner;
+        auto command = std::make_shared<SetPanning>();
+        command->panner  = &m_panners[panner];
+        command->panning = sanitize(panning);
+        command->frame   = toFrame(time);
+        return push(std::move(command));
+    }
+
+    int playSource(int panner, int source, Signal signal) {
+        if (!isOpen())
+            return SyntactsError_NotOpen;
+        if (!validPanner(panner))
+            return SyntactsError_InvalidPanner;
+        if (!validSource(source))
+            return SyntactsError_InvalidSource;
+        tact::prepare(signal, m_sampleRate, m_realTime.controlRate);
+        if (m_realTime.lockMemory)
+            prefault(signal);
+        auto command = std::make_shared<PlaySource>();
+        command->panner = &m_panners[panner];
+        command->source = source;
+        command->signal = std::move(signal);
+        return push(std::move(command));
+    }
+
+    int stopSource(int panner, int source) {
+        if (!isOpen())
+            return SyntactsError_NotOpen;
+        if (!validPanner(panner))
+            return SyntactsError_InvalidPanner;
+        if (!validSource(source))
+            return SyntactsError_InvalidSource;
+        auto command = std::make_shared<StopSource>();
+        command->panner = &m_panners[panner];
+        command->source = source;
+        return push(std::move(command));
+    }
+
+    int setSourcePanning(int panner, int source, const Panning& panning, double time = -1) {
+        if (!isOpen())
+            return SyntactsError_NotOpen;
+        if (!validPanner(panner))
+            return SyntactsError_InvalidPanner;
+        if (!validSource(source))
+            return SyntactsError_InvalidSource;
+        auto command = std::make_shared<SetSourcePanning>();
+        command->panner  = &m_panners[panner];
+        command->source  = source;
+        command->panning = sanitize(panning);
+        command->frame   = toFrame(time);
+        return push(std::move(command));
+    }
+
+    int setTrajectory(int panner, int source, Trajectory trajectory, double time = -1) {
+        if (!isOpen())
+            return SyntactsError_NotOpen;
+        if (!validPanner(panner))
+            return SyntactsError_InvalidPanner;
+        if (source != -1 && !validSource(source))
+            return SyntactsError_InvalidSource;
+        for (auto* signal : {&trajectory.x, &trajectory.y, &trajectory.radius}) {
+            tact::prepare(*signal, m_sampleRate, m_realTime.controlRate);
+            if (m_realTime.lockMemory)
+                prefault(*signal);
+        }
+        auto command = std::make_shared<SetTrajectory>();
+        command->panner     = &m_panners[panner];
+        command->source     = source;
+        command->trajectory = std::make_unique<Trajectory>(std::move(trajectory));
+        command->frame      = toFrame(time);
+        return push(std::move(command));
+    }
+
+    int clearTrajectory(int panner, int source) {
+        if (!isOpen())
+            return SyntactsError_NotOpen;
+        if (!validPanner(panner))
+            return SyntactsError_InvalidPanner;
+        if (source != -1 && !validSource(source))
+            return SyntactsError_InvalidSource;
+        auto command = std::make_shared<ClearTrajectory>();
+        command->panner = &m_panners[panner];
+        command->source = source;
+        return push(std::move(command));
+    }
+
+    static bool validSource(int source) {
+        return source >= 0 && source < SYNTACTS_MAX_SOURCES;
+    }
+
+    bool validPanner(int panner) const {
+        return panner >= 0 && panner < SYNTACTS_MAX_PANNERS && m_pannerOpen[panner];
+    }
+
+    /// Returns true if any panner has channels and something to evaluate (audio thread)
+    bool panning() const {
+        for (auto& p : m_panners) {
+            if (p.busy())
+                return true;
+        }
+        return false;
+    }
+
+    /// Sets channel spatial gains for a control block a fraction f through the current segment (audio thread)
+    void pan(int frames, double f) {
+        for (auto& p : m_panners) {
+            if (p.busy())
+                p.apply(m_channels, frames, f);
+        }
+    }
+
+    /// Adds panner sources to a rendered control block (audio thread)
+    void mix(float** out, unsigned long offset, int frames, double f) {
+        for (auto& p : m_panners) {
+            if (p.busy())
+                p.mix(m_channels, out, offset, frames, f);
+        }
+    }
+
+    /// Completes panner motion at the end of a segment (audio thread)
+    void settlePanners() {
+        for (auto& p : m_panners)
+            p.settle();
+    }
+
     const Device& getCurrentDevice() const {
         return m_device;
     }
@@ -487,14 +1505,49 @@ public:
         return s_count;
     }
 
-    void performCommands() {
+    /// Performs queued commands due in this buffer and defers later ones to the pending list.
+    /// If the pending list is full, later commands wait in the queue (in order) rather than run early.
+    void performCommands(std::uint64_t start) {
         while (m_commands.front()) {
-            auto command = *m_commands.front();
-            command->perform(m_channels[command->channel]);
+            auto& command = *m_commands.front();
+            if (command->frame > static_cast<std::int64_t>(start)) {
+                if (m_pending.size() == m_pending.capacity())
+                    return;
+                // pending is sorted by descending frame so the next command is at the back
+                auto it = std::upper_bound(m_pending.begin(), m_pending.end(), command->frame, 
+                    [](std::int64_t frame, const std::shared_ptr<Command>& c) { return frame > c->frame; });
+                m_pending.insert(it, std::move(command));
+            }
+            else {
+                command->perform(m_channels);
+                retire(std::move(command));
+            }
             m_commands.pop();
         }
     }
 
+    /// Hands a performed command back to the calling thread, so neither it nor what it swapped out is freed here
+    void retire(std::shared_ptr<Command>&& command) {
+        // the caller frees retired commands before each push, so room for every queued and pending command suffices
+        m_retired.try_push(std::move(command));
+    }
+
+    /// Frees commands retired by the audio thread (calling thread only)
+    void freeRetired() {
+        while (m_retired.front())
+            m_retired.pop();
+    }
+
+    /// Performs pending commands due at or before a frame
+    void performPending(std::uint64_t frame) {
+        while (!m_pending.empty() && m_pending.back()->frame <= static_cast<std::int64_t>(frame)) {
+            auto& command = m_pending.back();
+            command->perform(m_channels);
+            retire(std::move(command));
+            m_pending.pop_back();
+        }
+    }
+
     static int callback(const void *inputBuffer, void *outputBuffer,
                  unsigned long framesPerBuffer,
                  const PaStreamCallbackTimeInfo *timeInfo,
@@ -502,13 +1555,48 @@ public:
                  void *userData)
     {
         Session::Impl* session = (Session::Impl*)userData;
+        if (session->m_rtState == RealTimePending)
+            session->m_rtState = applyRealTime(session->m_realTime) ? RealTimeApplied : RealTimeFailed;
+        ScopedNoDenormals noDenormals(session->m_realTime.flushDenormals);
         auto& channels = session->m_channels;
-        session->performCommands();
+        auto& pending  = session->m_pending;
+        std::uint64_t start = session->m_frame.load(std::memory_order_relaxed);
+        session->performCommands(start);
         (void)inputBuffer;     
         float** out = (float**)outputBuffer;
-        for (std::size_t c = 0; c < channels.size(); ++c) {
-            channels[c].fillBuffer(out[c], framesPerBuffer);
+        // render in segments split at the frames of timed commands
+        unsigned long offset = 0;
+        while (offset < framesPerBuffer) {
+            unsigned long next = framesPerBuffer;
+            if (!pending.empty())
+                next = static_cast<unsigned long>(std::clamp<std::int64_t>(pending.back()->frame - static_cast<std::int64_t>(start), offset, framesPerBuffer));
+            if (next > offset) {
+                if (session->panning()) {
+                    // panners move from their current to target parameters across the segment
+                    for (unsigned long block = offset; block < next; block += SPATIAL_BLOCK) {
+                        unsigned long end = std::min<unsigned long>(block + SPATIAL_BLOCK, next);
+                        double f = static_cast<double>(end - offset) / (next - offset);
+                        session->pan(static_cast<int>(end - block), f);
+                        for (std::size_t c = 0; c < channels.size(); ++c)
+                            channels[c].fillBuffer(out[c] + block, end - block);
+                        session->mix(out, block, static_cast<int>(end - block), f);
+                    }
+                    session->settlePanners();
+                }
+                else {
+                    for (std::size_t c = 0; c < channels.size(); ++c)
+                        channels[c].fillBuffer(out[c] + offset, next - offset);
+                }
+            }
+            offset = next;
+            if (offset < framesPerBuffer)
+                session->performPending(start + offset);
         }
+        for (std::size_t c = 0; c < channels.size(); ++c)
+            session->m_states[c].store(channels[c].state(), std::memory_order_relaxed);
+        if (Recorder* recorder = session->m_recording.load(std::memory_order_acquire))
+            recorder->write(out, framesPerBuffer);
+        session->m_frame.store(start + framesPerBuffer, std::memory_order_release);
         return paContinue;
     }
 
@@ -602,12 +1690,34 @@ public:
     std::map<int, Device> m_devices;
 
     std::vector<Channel> m_channels;
+    std::unique_ptr<std::atomic<int>[]> m_states;
+
+    std::array<Panner, SYNTACTS_MAX_PANNERS> m_panners;   ///< panner state owned by the audio thread
+    std::array<bool, SYNTACTS_MAX_PANNERS> m_pannerOpen = {}; ///< panners handed out by openPanner
 
     SPSCQueue<std::shared_ptr<Command>> m_commands;
+    SPSCQueue<std::shared_ptr<Command>> m_retired;  ///< performed commands returned to the calling thread to be freed
+    std::vector<std::shared_ptr<Command>> m_pending; ///< timed commands sorted by descending frame
+    std::atomic<std::uint64_t> m_frame = 0;         ///< frames rendered since the Session was opened
+
+    std::unique_ptr<Recorder> m_recorder;
+    std::atomic<Recorder*> m_recording = nullptr;    ///< recorder visible to the audio thread
+
+    SPSCQueue<Event> m_events;
+    std::atomic<std::uint64_t> m_droppedEvents = 0; ///< voice events dropped since the Session was opened
+    std::mutex m_eventMutex;
+    std::function<void(const Event&)> m_eventCallback;
+    std::thread m_eventThread;
+    std::atomic<bool> m_dispatching = false;
     PaStream* m_stream;
 
     double m_sampleRate = 0;
 
+    enum RealTimeState { RealTimePending, RealTimeApplied, RealTimeFailed };
+    RealTime m_realTime;
+    std::atomic<RealTimeState> m_rtState = RealTimePending;
+    bool m_memoryLocked = false; ///< true while this Session holds a lockMemory reference
+
     static int s_count;
 };
 
@@ -675,6 +1785,14 @@ int Session::close() {
     return m_impl->close();
 }
 
+int Session::setRealTime(const RealTime& options) {
+    return m_impl->setRealTime(options);
+}
+
+const RealTime& Session::getRealTime() const {
+    return m_impl->getRealTime();
+}
+
 bool Session::isOpen() const {
     return m_impl->isOpen();
 }
@@ -683,6 +1801,10 @@ int Session::play(int channel, Signal signal) {
     return m_impl->play(channel, std::move(signal));
 }
 
+int Session::play(int channel, Signal signal, double time) {
+    return m_impl->play(channel, std::move(signal), time);
+}
+
 bool Session::isPlaying(int channel) {
     return m_impl->isPlaying(channel);
 }
@@ -691,7 +1813,28 @@ bool Session::isPaused(int channel) {
     return m_impl->isPaused(channel);
 }
 
+bool Session::pollEvent(Event& event) {
+    return m_impl->pollEvent(event);
+}
+
+std::uint64_t Session::getDroppedEvents() const {
+    return m_impl->getDroppedEvents();
+}
+
+void Session::setEventCallback(std::function<void(const Event&)> callback) {
+    m_impl->setEventCallback(std::move(callback));
+}
+
+int Session::prepare(Signal& signal) {
+    if (!isOpen())
+        return SyntactsError_NotOpen;
+    tact::prepare(signal, getSampleRate(), getRealTime().controlRate, MAX_BAKE_SIZE);
+    return SyntactsError_NoError;
+}
+
 int Session::playAll(Signal signal) {
+    // bake once so every channel's copy shares the buffers
+    tact::prepare(signal, getSampleRate(), getRealTime().controlRate);
     for (int i = 0; i < getChannelCount(); ++i) {
         if (int ret = play(i, signal) != SyntactsError_NoError)
             return ret;
@@ -703,6 +1846,10 @@ int Session::stop(int channel) {
     return m_impl->stop(channel);
 }
 
+int Session::stop(int channel, double time) {
+    return m_impl->stop(channel, time);
+}
+
 int Session::stopAll() {
     for (int i = 0; i < getChannelCount(); ++i) {
         if (int ret = stop(i) != SyntactsError_NoError)
@@ -715,6 +1862,10 @@ int Session::pause(int channel) {
     return m_impl->pause(channel, true);
 }
 
+int Session::pause(int channel, double time) {
+    return m_impl->pause(channel, true, time);
+}
+
 int Session::pauseAll() {
     for (int i = 0; i < getChannelCount(); ++i) {
         if (int ret = pause(i) != SyntactsError_NoError)
@@ -727,6 +1878,10 @@ int Session::resume(int channel) {
     return m_impl->pause(channel, false);
 }
 
+int Session::resume(int channel, double time) {
+    return m_impl->pause(channel, false, time);
+}
+
 int Session::resumeAll() {
     for (int i = 0; i < getChannelCount(); ++i) {
         if (int ret = resume(i) != SyntactsError_NoError)
@@ -739,6 +1894,10 @@ int Session::setVolume(int channel, double volume) {
     return m_impl->setVolume(channel, volume);
 }
 
+int Session::setVolume(int channel, double volume, double time) {
+    return m_impl->setVolume(channel, volume, time);
+}
+
 double Session::getVolume(int channel) {
     return m_impl->getVolume(channel);
 }
@@ -748,6 +1907,10 @@ int Session::setPitch(int channel, double pitch) {
     return m_impl->setPitch(channel, pitch);
 }
 
+int Session::setPitch(int channel, double pitch, double time) {
+    return m_impl->setPitch(channel, pitch, time);
+}
+
 double Session::getPitch(int channel) {
     return m_impl->getPitch(channel);
 }
@@ -756,6 +1919,68 @@ double Session::getLevel(int channel) {
     return m_impl->getLevel(channel);
 }
 
+int Session::openPanner() {
+    return m_impl->openPanner();
+}
+
+int Session::closePanner(int panner) {
+    return m_impl->closePanner(panner);
+}
+
+int Session::setPannerChannels(int panner, const std::vector<int>& channels, const std::vector<double>& x, const std::vector<double>& y, 
+                               const std::vector<double>& z, const std::vector<double>& gains) 
+{
+    return m_impl->setPannerChannels(panner, channels, x, y, z, gains);
+}
+
+int Session::setPanning(int panner, const Panning& panning) {
+    return m_impl->setPanning(panner, panning);
+}
+
+int Session::setPanning(int panner, const Panning& panning, double time) {
+    return m_impl->setPanning(panner, panning, time);
+}
+
+int Session::playSource(int panner, int source, Signal signal) {
+    return m_impl->playSource(panner, source, std::move(signal));
+}
+
+int Session::stopSource(int panner, int source) {
+    return m_impl->stopSource(panner, source);
+}
+
+int Session::setSourcePanning(int panner, int source, const Panning& panning) {
+    return m_impl->setSourcePanning(panner, source, panning);
+}
+
+int Session::setSourcePanning(int panner, int source, const Panning& panning, double time) {
+    return m_impl->setSourcePanning(panner, source, panning, time);
+}
+
+int Session::setTrajectory(int panner, const Trajectory& trajectory) {
+    return m_impl->setTrajectory(panner, -1, trajectory);
+}
+
+int Session::setTrajectory(int panner, const Trajectory& trajectory, double time) {
+    return m_impl->setTrajectory(panner, -1, trajectory, time);
+}
+
+int Session::clearTrajectory(int panner) {
+    return m_impl->clearTrajectory(panner, -1);
+}
+
+int Session::setSourceTrajectory(int panner, int source, const Trajectory& trajectory) {
+    return m_impl->setTrajectory(panner, source, trajectory);
+}
+
+int Session::setSourceTrajectory(int panner, int source, const Trajectory& trajectory, double time) {
+    return m_impl->setTrajectory(panner, source, trajectory, time);
+}
+
+int Session::clearSourceTrajectory(int panner, int source) {
+    return m_impl->clearTrajectory(panner, source);
+}
+
 const Device& Session::getCurrentDevice() const {
     return m_impl->getCurrentDevice();
 }
@@ -780,6 +2005,22 @@ double Session::getCpuLoad() const {
     return m_impl->getCpuLoad();
 }
 
+double Session::getTime() const {
+    return m_impl->getTime();
+}
+
+int Session::startRecording(const std::string& filePath) {
+    return m_impl->startRecording(filePath);
+}
+
+int Session::stopRecording() {
+    return m_impl->stopRecording();
+}
+
+bool Session::isRecording() const {
+    return m_impl->isRecording();
+}
+
 int Session::count() {
     return Impl::count();
 }
@@ -0,0 +1,214 @@
+#include "Tact/SharedMemory.hpp"
+#include <iostream>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+namespace tact {
+namespace shm {
+
+///////////////////////////////////////////////////////////////////////////////
+// RING
+///////////////////////////////////////////////////////////////////////////////
+
+void initialize(Region* region, int channelCount, double sampleRate) {
+    region->magic.store(0, std::memory_order_relaxed);
+    region->version      = VERSION;
+    region->channelCount = channelCount;
+    region->sampleRate   = sampleRate;
+    region->tail.store(0, std::memory_order_relaxed);
+    region->head.store(0, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < SLOT_COUNT; ++i)
+        region->slots[i].sequence.store(i, std::memory_order_relaxed);
+    // publish magic last so clients never see a half-initialized region
+    region->magic.store(MAGIC, std::memory_order_release);
+}
+
+Slot* claim(Region* region, std::uint64_t& position) {
+    position = region->tail.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot* slot = &region->slots[position & (SLOT_COUNT - 1)];
+        std::uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+        std::int64_t diff = static_cast<std::int64_t>(seq) - static_cast<std::int64_t>(position);
+        if (diff == 0) {
+            if (region->tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                return slot;
+        }
+        else if (diff < 0)
+            return nullptr; // full
+        else
+            position = region->tail.load(std::memory_order_relaxed);
+    }
+}
+
+bool publish(Slot* slot, std::uint64_t position) {
+    // fails if the consumer has reclaimed the slot, which moves its sequence past position
+    return slot->sequence.compare_exchange_strong(position, position + 1, std::memory_order_release, std::memory_order_relaxed);
+}
+
+Slot* front(Region* region) {
+    std::uint64_t position = region->head.load(std::memory_order_relaxed);
+    Slot* slot = &region->slots[position & (SLOT_COUNT - 1)];
+    if (slot->sequence.load(std::memory_order_acquire) != position + 1)
+        return nullptr;
+    return slot;
+}
+
+void pop(Region* region) {
+    std::uint64_t position = region->head.load(std::memory_order_relaxed);
+    Slot* slot = &region->slots[position & (SLOT_COUNT - 1)];
+    slot->sequence.store(position + SLOT_COUNT, std::memory_order_release);
+    region->head.store(position + 1, std::memory_order_relaxed);
+}
+
+bool claimed(Region* region) {
+    std::uint64_t position = region->head.load(std::memory_order_relaxed);
+    Slot* slot = &region->slots[position & (SLOT_COUNT - 1)];
+    return slot->sequence.load(std::memory_order_acquire) == position && region->tail.load(std::memory_order_relaxed) > position;
+}
+
+bool reclaim(Region* region) {
+    std::uint64_t position = region->head.load(std::memory_order_relaxed);
+    Slot* slot = &region->slots[position & (SLOT_COUNT - 1)];
+    if (region->tail.load(std::memory_order_relaxed) <= position)
+        return false;
+    // skip the slot as if it was popped, unless its producer publishes it first
+    std::uint64_t expected = position;
+    if (!slot->sequence.compare_exchange_strong(expected, position + SLOT_COUNT, std::memory_order_acq_rel, std::memory_order_relaxed))
+        return false;
+    region->head.store(position + 1, std::memory_order_relaxed);
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// MAPPING
+///////////////////////////////////////////////////////////////////////////////
+
+Mapping::Mapping() : m_size(0), m_data(nullptr), m_handle(nullptr), m_owner(false) { }
+
+Mapping::~Mapping() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool Mapping::create(const std::string& name, std::size_t size) {
+    close();
+    std::string path = "Local\\" + name;
+    HANDLE handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                       static_cast<DWORD>((std::uint64_t)size >> 32),
+                                       static_cast<DWORD>(size & 0xFFFFFFFF), path.c_str());
+    if (handle == NULL) {
+        std::cout << "Failed to create shared memory " << path << std::endl;
+        return false;
+    }
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        std::cout << "Shared memory " << path << " is already in use by another server" << std::endl;
+        CloseHandle(handle);
+        return false;
+    }
+    void* data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (data == NULL) {
+        CloseHandle(handle);
+        return false;
+    }
+    m_name = name; m_size = size; m_data = data; m_handle = handle; m_owner = true;
+    return true;
+}
+
+bool Mapping::open(const std::string& name, std::size_t size) {
+    close();
+    std::string path = "Local\\" + name;
+    HANDLE handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, path.c_str());
+    if (handle == NULL)
+        return false;
+    void* data = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (data == NULL) {
+        CloseHandle(handle);
+        return false;
+    }
+    m_name = name; m_size = size; m_data = data; m_handle = handle; m_owner = false;
+    return true;
+}
+
+void Mapping::close() {
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_handle)
+        CloseHandle(m_handle);
+    m_data = nullptr; m_handle = nullptr; m_size = 0; m_owner = false;
+}
+
+#else
+
+bool Mapping::create(const std::string& name, std::size_t size) {
+    close();
+    std::string path = "/" + name;
+    // only the owning user may map the region, since its commands drive the Session
+    int fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        std::cout << "Shared memory " << path << " is already in use by another server" 
+                  << " (remove /dev/shm" << path << " if that server did not shut down cleanly)" << std::endl;
+        return false;
+    }
+    if (fd < 0) {
+        std::cout << "Failed to create shared memory " << path << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        shm_unlink(path.c_str());
+        return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        shm_unlink(path.c_str());
+        return false;
+    }
+    m_name = name; m_size = size; m_data = data; m_owner = true;
+    return true;
+}
+
+bool Mapping::open(const std::string& name, std::size_t size) {
+    close();
+    std::string path = "/" + name;
+    int fd = shm_open(path.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < size) {
+        ::close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+        return false;
+    m_name = name; m_size = size; m_data = data; m_owner = false;
+    return true;
+}
+
+void Mapping::close() {
+    if (m_data)
+        munmap(m_data, m_size);
+    if (m_owner)
+        shm_unlink(("/" + m_name).c_str());
+    m_data = nullptr; m_size = 0; m_owner = false;
+}
+
+#endif
+
+void* Mapping::data() const {
+    return m_data;
+}
+
+} // namespace shm
+} // namespace tact
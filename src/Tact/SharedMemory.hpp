@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// Private protocol shared by tact::Server and tact::Client. Commands travel through a
+// bounded multi-producer/single-consumer ring (Vyukov) living in named shared memory.
+
+namespace tact {
+namespace shm {
+
+///////////////////////////////////////////////////////////////////////////////
+
+constexpr std::uint32_t MAGIC        = 0x54584E53; // "SNXT"
+constexpr std::uint32_t VERSION      = 2;
+constexpr std::size_t   SLOT_COUNT   = 256;        // must be a power of two
+constexpr std::size_t   PAYLOAD_SIZE = 64 * 1024;  // max serialized Signal or library name size
+
+static_assert((SLOT_COUNT & (SLOT_COUNT - 1)) == 0, "SLOT_COUNT must be a power of two");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared memory requires lock-free 64-bit atomics");
+
+/// Command operations
+enum Op : std::uint32_t {
+    OpPlay        = 0, ///< payload is a Signal encoded with Library::encodeSignal
+    OpPlayLibrary = 1, ///< payload is the name of a Signal in the Syntacts Library
+    OpStop        = 2,
+    OpStopAll     = 3,
+    OpPause       = 4,
+    OpResume      = 5,
+    OpSetVolume   = 6,
+    OpSetPitch    = 7
+};
+
+/// A single command slot in the ring
+struct alignas(64) Slot {
+    std::atomic<std::uint64_t> sequence;
+    std::uint32_t op;
+    std::int32_t  channel;
+    double        value;
+    std::uint32_t size;
+    char          payload[PAYLOAD_SIZE];
+};
+
+/// Shared memory layout
+struct Region {
+    std::atomic<std::uint32_t> magic; ///< MAGIC while a Server is servicing the region
+    std::uint32_t version;
+    std::int32_t  channelCount;
+    double        sampleRate;
+    alignas(64) std::atomic<std::uint64_t> tail; ///< next position claimed by producers
+    alignas(64) std::atomic<std::uint64_t> head; ///< next position read by the consumer
+    Slot slots[SLOT_COUNT];
+};
+
+/// Initializes a freshly created Region
+void initialize(Region* region, int channelCount, double sampleRate);
+
+/// Claims a slot for writing (multiple producers). Returns nullptr if the ring is full.
+Slot* claim(Region* region, std::uint64_t& position);
+
+/// Publishes a claimed slot to the consumer. Returns false if the consumer reclaimed it first (see reclaim).
+bool publish(Slot* slot, std::uint64_t position);
+
+/// Returns the next readable slot (single consumer) or nullptr if the ring is empty.
+Slot* front(Region* region);
+
+/// Releases the slot returned by front() back to producers.
+void pop(Region* region);
+
+/// Returns true if the next slot has been claimed by a producer but not yet published (single consumer).
+bool claimed(Region* region);
+
+/// Releases the next slot back to producers if it is still claimed and unpublished, e.g. because its producer died
+/// between claim and publish. Returns true if it was released (single consumer).
+bool reclaim(Region* region);
+
+///////////////////////////////////////////////////////////////////////////////
+
+/// A named memory mapping shared between processes
+class Mapping {
+public:
+    Mapping();
+    ~Mapping();
+    /// Creates (or replaces) a named mapping of size bytes.
+    bool create(const std::string& name, std::size_t size);
+    /// Opens an existing named mapping of size bytes.
+    bool open(const std::string& name, std::size_t size);
+    /// Unmaps (and removes if created) the mapping.
+    void close();
+    /// Returns the mapped memory or nullptr.
+    void* data() const;
+private:
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+    std::string m_name;
+    std::size_t m_size;
+    void* m_data;
+    void* m_handle;
+    bool m_owner;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+} // namespace shm
+} // namespace tact
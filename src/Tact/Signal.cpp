@@ -9,7 +9,9 @@ Signal::Signal() : Signal(Scalar(0)) {}
     Signal::Signal(const Signal& other) :
         gain(other.gain),
         bias(other.bias),
-        m_ptr(other.m_ptr->copy())
+        m_ptr(other.m_ptr->copy()),
+        m_length(other.m_length),
+        m_peak(other.m_peak)
     {  }
     Signal& Signal::operator=(const Signal& other)
     {
@@ -27,6 +29,22 @@ void* Signal::get() const
     return m_ptr->get(); 
 }
 
+void* Signal::get()
+{ 
+#ifndef SYNTACTS_USE_SHARED_PTR
+    m_length = m_peak = NAN;
+#endif
+    return m_ptr->get(); 
+}
+
+void Signal::refresh()
+{
+#ifndef SYNTACTS_USE_SHARED_PTR
+    m_length = m_ptr->length();
+    m_peak   = m_ptr->peak();
+#endif
+}
+
 int Signal::Concept::s_count = 0;
 
 } // namespace tact
\ No newline at end of file
@@ -1,34 +1,193 @@
 #include <Tact/Spatializer.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 
 namespace tact {
 
-inline double wrappedDifference(double p1, double p2, double interval) { 
-    // double half = interval * 0.5;
-    // double diff = fmod(p2 - p1 + half, interval) - half;
-    // return diff + (diff < -half) * interval;
-    return p1 - p2 - floor(((p1 - p2) + interval * 0.5) / interval) * interval;
+namespace {
+
+/// Gets the grid cell containing a coordinate
+inline int cellAt(double v, double min, double inv, int count) {
+    return std::clamp(static_cast<int>((v - min) * inv), 0, count - 1);
+}
+
+} // private namespace
+
+SpatialIndex::SpatialIndex() :
+    m_epoch(0),
+    m_min{0,0,0}, m_max{0,0,0},
+    m_inv{0,0,0},
+    m_cells{0,0,0}
+{ }
+
+void SpatialIndex::build(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& z) {
+    assert(x.size() == y.size() && (z.empty() || z.size() == x.size()));
+    m_x = x;
+    m_y = y;
+    m_z = z.empty() ? std::vector<double>(x.size(), 0.0) : z;
+    int n = size();
+    m_stamps.assign(n, 0);
+    m_epoch = 0;
+    m_items.resize(n);
+    if (n == 0) {
+        m_cells[0] = m_cells[1] = m_cells[2] = 0;
+        m_cellStart.clear();
+        return;
+    }
+    const std::vector<double>* axes[3] = {&m_x, &m_y, &m_z};
+    bool flat[3];
+    for (int a = 0; a < 3; ++a) {
+        m_min[a] = *std::min_element(axes[a]->begin(), axes[a]->end());
+        m_max[a] = *std::max_element(axes[a]->begin(), axes[a]->end());
+        flat[a] = !(m_max[a] > m_min[a]);
+    }
+    // about one position per cell, with cells as cubic as the extents allow (axes thinner than a cell get one cell)
+    double cell = 1;
+    for (bool changed = true; changed;) {
+        changed = false;
+        double volume = 1;
+        int dims = 0;
+        for (int a = 0; a < 3; ++a) {
+            if (!flat[a]) {
+                volume *= m_max[a] - m_min[a];
+                dims++;
+            }
+        }
+        cell = dims > 0 ? std::pow(volume / n, 1.0 / dims) : 1;
+        for (int a = 0; a < 3; ++a) {
+            if (!flat[a] && m_max[a] - m_min[a] < cell) 
+                flat[a] = changed = true;
+        }
+    }
+    for (int a = 0; a < 3; ++a) {
+        double span = m_max[a] - m_min[a];
+        m_cells[a] = span > 0 ? std::clamp(static_cast<int>(std::ceil(span / cell)), 1, n) : 1;
+        m_inv[a]   = span > 0 ? m_cells[a] / span : 0;
+    }
+    // counting sort positions into cells
+    m_cellStart.assign(m_cells[0] * m_cells[1] * m_cells[2] + 1, 0);
+    for (int k = 0; k < n; ++k)
+        m_cellStart[cellOf(k) + 1]++;
+    for (std::size_t c = 1; c < m_cellStart.size(); ++c)
+        m_cellStart[c] += m_cellStart[c-1];
+    std::vector<int> fill(m_cellStart.begin(), m_cellStart.end() - 1);
+    for (int k = 0; k < n; ++k)
+        m_items[fill[cellOf(k)]++] = k;
+}
+
+void SpatialIndex::query(double x, double y, double z, double rx, double ry, double rz, double wrapX, double wrapY, std::vector<int>& out) {
+    out.clear();
+    nextEpoch();
+    if (size() == 0 || !(rx > 0 && ry > 0 && rz > 0))
+        return;
+    // a target that can reach a position through more than one wrapped image covers everything
+    if ((wrapX > 0 && 2 * rx >= wrapX) || (wrapY > 0 && 2 * ry >= wrapY)) {
+        queryAll(out);
+        return;
+    }
+    // visit each wrapped image of the target that overlaps the indexed positions
+    int kx0 = 0, kx1 = 0, ky0 = 0, ky1 = 0;
+    if (wrapX > 0) {
+        kx0 = static_cast<int>(std::ceil((m_min[0] - rx - x) / wrapX));
+        kx1 = static_cast<int>(std::floor((m_max[0] + rx - x) / wrapX));
+    }
+    if (wrapY > 0) {
+        ky0 = static_cast<int>(std::ceil((m_min[1] - ry - y) / wrapY));
+        ky1 = static_cast<int>(std::floor((m_max[1] + ry - y) / wrapY));
+    }
+    for (int ky = ky0; ky <= ky1; ++ky) {
+        for (int kx = kx0; kx <= kx1; ++kx)
+            gather(x + kx * wrapX, y + ky * wrapY, z, rx, ry, rz, out);
+    }
+}
+
+void SpatialIndex::queryAll(std::vector<int>& out) {
+    out.clear();
+    nextEpoch();
+    for (int k = 0; k < size(); ++k) {
+        m_stamps[k] = m_epoch;
+        out.push_back(k);
+    }
+}
+
+void SpatialIndex::nextEpoch() {
+    if (++m_epoch == 0) {
+        std::fill(m_stamps.begin(), m_stamps.end(), 0);
+        m_epoch = 1;
+    }
+}
+
+int SpatialIndex::cellOf(int k) const {
+    int cx = cellAt(m_x[k], m_min[0], m_inv[0], m_cells[0]);
+    int cy = cellAt(m_y[k], m_min[1], m_inv[1], m_cells[1]);
+    int cz = cellAt(m_z[k], m_min[2], m_inv[2], m_cells[2]);
+    return (cz * m_cells[1] + cy) * m_cells[0] + cx;
+}
+
+void SpatialIndex::gather(double x, double y, double z, double rx, double ry, double rz, std::vector<int>& out) {
+    double c[3] = {x, y, z}, r[3] = {rx, ry, rz};
+    int lo[3], hi[3];
+    for (int a = 0; a < 3; ++a) {
+        if (c[a] + r[a] < m_min[a] || c[a] - r[a] > m_max[a])
+            return;
+        lo[a] = cellAt(c[a] - r[a], m_min[a], m_inv[a], m_cells[a]);
+        hi[a] = cellAt(c[a] + r[a], m_min[a], m_inv[a], m_cells[a]);
+    }
+    for (int cz = lo[2]; cz <= hi[2]; ++cz) {
+        for (int cy = lo[1]; cy <= hi[1]; ++cy) {
+            for (int cx = lo[0]; cx <= hi[0]; ++cx) {
+                int cell = (cz * m_cells[1] + cy) * m_cells[0] + cx;
+                for (int i = m_cellStart[cell]; i < m_cellStart[cell + 1]; ++i) {
+                    int k = m_items[i];
+                    if (m_stamps[k] != m_epoch) {
+                        m_stamps[k] = m_epoch;
+                        out.push_back(k);
+                    }
+                }
+            }
+        }
+    }
 }
 
 Spatializer::Spatializer(Session* session) :
-    m_session(session),
+    m_session(nullptr),
     m_target({0.5,0.5}),
     m_radius(0.25),
     m_volume(1),
     m_pitch(1),
     m_rollOff(Curves::Linear()),
     m_autoUpdate(true),
-    m_wrapInterval({0,0})
+    m_wrapInterval({0,0}),
+    m_kernel({1,1,1}),
+    m_nearest(0),
+    m_panner(-1),
+    m_dirty(true),
+    m_moving(false),
+    m_motionSent(false)
 {
-    
+    bind(session);
 }
 
 Spatializer::~Spatializer() {
-    clear();
+    unbind();
 }
 
 void Spatializer::bind(Session* session) {
     unbind();
     m_session = session;
+    if (m_session) {
+        m_panner = m_session->openPanner();
+        m_dirty = true;
+        m_motionSent = false;
+        for (auto& pair : m_sources) {
+            pair.second.started = false;
+            pair.second.dirty = true;
+            pair.second.motionSent = false;
+        }
+        if (m_autoUpdate)
+            update();
+    }
 } 
 
 void Spatializer::unbind() {
@@ -37,21 +196,30 @@ void Spatializer::unbind() {
         for (auto& pair : m_positions) {
             int ch = pair.first;
             m_session->stop(ch);
-            m_session->setVolume(ch, 1.0f);
             m_session->setPitch(ch, 1.0f);
         }
+        if (m_panner >= 0)
+            m_session->closePanner(m_panner);
+        m_motionSent = false;
+        for (auto& pair : m_sources) {
+            pair.second.started = false;
+            pair.second.motionSent = false;
+        }
     }
     m_session = nullptr;
+    m_panner = -1;
 }
 
-void Spatializer::setPosition(int channel, double x, double y) {
-    m_positions[channel] = {x,y};
-    if (m_autoUpdate)
-        update();
+void Spatializer::setPosition(int channel, double x, double y, double z) {
+    setPosition(channel, Point{x,y,z});
 }
 
 void Spatializer::setPosition(int channel, const Point& p) {
+    auto it = m_positions.find(channel);
+    if (it != m_positions.end() && it->second.x == p.x && it->second.y == p.y && it->second.z == p.z)
+        return;
     m_positions[channel] = p;
+    m_dirty = true;
     if (m_autoUpdate)
         update();
 }
@@ -60,8 +228,19 @@ Spatializer::Point Spatializer::getPosition(int channel) const {
     return m_positions.at(channel);
 }
 
-void Spatializer::setTarget(double x, double y) {
-    m_target = {x,y};
+void Spatializer::setCalibration(int channel, double gain) {
+    m_calibration[channel] = gain;
+    m_dirty = true;
+    if (m_autoUpdate)
+        update();
+}
+
+double Spatializer::getCalibration(int channel) const {
+    return m_calibration.count(channel) ? m_calibration.at(channel) : 1.0;
+}
+
+void Spatializer::setTarget(double x, double y, double z) {
+    m_target = {x,y,z};
     if (m_autoUpdate)
         update();
 }
@@ -97,19 +276,78 @@ Curve Spatializer::getRollOff() const {
     return m_rollOff;
 }
 
+void Spatializer::setKernel(double x, double y, double z) {
+    assert(x > 0 && y > 0 && z > 0);
+    m_kernel = {x,y,z};
+    for (auto& pair : m_sources)
+        pair.second.dirty = true;
+    if (m_autoUpdate)
+        update();
+}
+
+const Spatializer::Point& Spatializer::getKernel() const {
+    return m_kernel;
+}
+
+void Spatializer::setNearest(int k) {
+    m_nearest = std::max(0, k);
+    for (auto& pair : m_sources)
+        pair.second.dirty = true;
+    if (m_autoUpdate)
+        update();
+}
+
+int Spatializer::getNearest() const {
+    return m_nearest;
+}
+
 void Spatializer::setWrap(double x_interval, double y_interval) {
-    m_wrapInterval.x = x_interval;
-    m_wrapInterval.y = y_interval;
+    setWrap(Point{x_interval, y_interval});
 }
 
 void Spatializer::setWrap(const Point& wrapInterval) {
     m_wrapInterval = wrapInterval;
+    for (auto& pair : m_sources)
+        pair.second.dirty = true;
 }
 
 const Spatializer::Point& Spatializer::getWrap() const {
     return m_wrapInterval;
 }
 
+void Spatializer::setTrajectory(Signal x, Signal y) {
+    m_trajectory.x = std::move(x);
+    m_trajectory.y = std::move(y);
+    m_trajectory.hasRadius = false;
+    move();
+}
+
+void Spatializer::setTrajectory(Signal x, Signal y, Signal r) {
+    m_trajectory.x = std::move(x);
+    m_trajectory.y = std::move(y);
+    m_trajectory.radius = std::move(r);
+    m_trajectory.hasRadius = true;
+    move();
+}
+
+void Spatializer::move() {
+    m_moving = true;
+    m_motionSent = false;
+    if (m_autoUpdate)
+        update();
+}
+
+void Spatializer::clearTrajectory() {
+    if (m_moving && m_motionSent && m_session && m_panner >= 0)
+        m_session->clearTrajectory(m_panner);
+    m_moving = false;
+    m_motionSent = false;
+}
+
+bool Spatializer::hasTrajectory() const {
+    return m_moving;
+}
+
 bool Spatializer::createGrid(int rows, int cols) {
     clear();
     int n_ch = m_session->getChannelCount();
@@ -121,9 +359,12 @@ bool Spatializer::createGrid(int rows, int cols) {
             float x = (float)c / (float)(cols-1);
             float y = (float)r / (float)(rows-1);
             m_positions[ch] = {x,y};
+            m_dirty = true;
             ch++;
         }
     }
+    if (m_autoUpdate)
+        update();
     return true;
 }
 
@@ -132,21 +373,25 @@ void Spatializer::clear() {
         for (auto& pair : m_positions) {
             int ch = pair.first;
             m_session->stop(ch);
-            m_session->setVolume(ch, 1.0);
             m_session->setPitch(ch, 1.0);
         }
     } 
-    m_positions.clear();        
+    m_positions.clear();
+    m_dirty = true;
+    if (m_autoUpdate)
+        update();
 }
 
 void Spatializer::remove(int channel) {
     if (m_positions.count(channel)) {
         if (m_session) {
             m_session->stop(channel);
-            m_session->setVolume(channel, 1.0);
             m_session->setPitch(channel, 1.0);
         }
         m_positions.erase(channel);
+        m_dirty = true;
+        if (m_autoUpdate)
+            update();
     }
 }
 
@@ -174,14 +419,146 @@ void Spatializer::play(Signal signal) {
 }
 
 void Spatializer::stop() {
+    for (auto& pair : m_sources)
+        pair.second.playing = false;
     if (m_session == nullptr)
         return;
     for (auto& pair : m_positions) 
         m_session->stop(pair.first);
+    if (m_panner >= 0) {
+        for (auto& pair : m_sources)
+            m_session->stopSource(m_panner, pair.first);
+    }
+}
+
+int Spatializer::addSource(Signal signal, double x, double y) {
+    int source = 0;
+    while (m_sources.count(source))
+        source++;
+    if (source >= SYNTACTS_MAX_SOURCES)
+        return SyntactsError_InvalidSource;
+    m_sources[source] = Source{{x,y}, m_radius, 1, m_rollOff, std::move(signal), true, false, true, Trajectory(), false, false};
+    if (m_autoUpdate)
+        update();
+    return source;
+}
+
+void Spatializer::playSource(int source, Signal signal) {
+    if (!m_sources.count(source))
+        return;
+    auto& s = m_sources.at(source);
+    s.signal  = std::move(signal);
+    s.playing = true;
+    s.started = false;
+    touch(source);
+}
+
+void Spatializer::removeSource(int source) {
+    if (!m_sources.count(source))
+        return;
+    if (m_session && m_panner >= 0)
+        m_session->stopSource(m_panner, source);
+    m_sources.erase(source);
+}
+
+void Spatializer::setSourcePosition(int source, double x, double y, double z) {
+    if (!m_sources.count(source))
+        return;
+    m_sources.at(source).position = {x,y,z};
+    touch(source);
+}
+
+Spatializer::Point Spatializer::getSourcePosition(int source) const {
+    return m_sources.at(source).position;
+}
+
+void Spatializer::setSourceRadius(int source, double r) {
+    assert(r > 0);
+    if (!m_sources.count(source))
+        return;
+    m_sources.at(source).radius = r;
+    touch(source);
+}
+
+double Spatializer::getSourceRadius(int source) const {
+    return m_sources.at(source).radius;
+}
+
+void Spatializer::setSourceVolume(int source, double volume) {
+    if (!m_sources.count(source))
+        return;
+    m_sources.at(source).volume = volume;
+    touch(source);
+}
+
+double Spatializer::getSourceVolume(int source) const {
+    return m_sources.at(source).volume;
+}
+
+void Spatializer::setSourceRollOff(int source, Curve rollOff) {
+    if (!m_sources.count(source))
+        return;
+    m_sources.at(source).rollOff = rollOff;
+    touch(source);
+}
+
+void Spatializer::setSourceTrajectory(int source, Signal x, Signal y) {
+    if (!m_sources.count(source))
+        return;
+    auto& s = m_sources.at(source);
+    s.trajectory.x = std::move(x);
+    s.trajectory.y = std::move(y);
+    s.trajectory.hasRadius = false;
+    move(source);
+}
+
+void Spatializer::setSourceTrajectory(int source, Signal x, Signal y, Signal r) {
+    if (!m_sources.count(source))
+        return;
+    auto& s = m_sources.at(source);
+    s.trajectory.x = std::move(x);
+    s.trajectory.y = std::move(y);
+    s.trajectory.radius = std::move(r);
+    s.trajectory.hasRadius = true;
+    move(source);
+}
+
+void Spatializer::move(int source) {
+    auto& s = m_sources.at(source);
+    s.moving = true;
+    s.motionSent = false;
+    if (m_autoUpdate)
+        update();
+}
+
+void Spatializer::clearSourceTrajectory(int source) {
+    if (!m_sources.count(source))
+        return;
+    auto& s = m_sources.at(source);
+    if (s.moving && s.motionSent && m_session && m_panner >= 0)
+        m_session->clearSourceTrajectory(m_panner, source);
+    s.moving = false;
+    s.motionSent = false;
+}
+
+int Spatializer::getSourceCount() const {
+    return (int)m_sources.size();
+}
+
+bool Spatializer::hasSource(int source) const {
+    return m_sources.count(source) > 0;
+}
+
+void Spatializer::touch(int source) {
+    m_sources.at(source).dirty = true;
+    if (m_autoUpdate)
+        update();
 }
 
 void Spatializer::setVolume(double volume) {
     m_volume = volume;
+    for (auto& pair : m_sources)
+        pair.second.dirty = true;
     if (m_autoUpdate)
         update();
 }
@@ -207,23 +584,84 @@ void Spatializer::autoUpdate(bool enable) {
 }
 
 void Spatializer::update() {
-    if (m_session == nullptr)
+    update(-1);
+}
+
+void Spatializer::update(double time) {
+    if (m_session == nullptr || m_panner < 0)
         return;
-    for (auto& pair : m_positions) {
-        int ch = pair.first;
-        Point v;
-        v.x = m_wrapInterval.x > 0 
-            ? wrappedDifference(pair.second.x, m_target.x, m_wrapInterval.x)
-            : pair.second.x - m_target.x;
-        
-        v.y = m_wrapInterval.y > 0 
-            ? wrappedDifference(pair.second.y, m_target.y, m_wrapInterval.y)
-            : v.y = pair.second.y - m_target.y; 
-        double d = std::sqrt(v.x*v.x + v.y*v.y);
-        double vol = 1.0 - clamp01(d / m_radius);
-        vol = m_rollOff(vol);
-        vol *= m_volume;
-        m_session->setVolume(ch, vol);
+    // channel positions are only uploaded when they change
+    if (m_dirty) {
+        std::vector<int> channels;
+        std::vector<double> x, y, z, gains;
+        channels.reserve(m_positions.size());
+        x.reserve(m_positions.size());
+        y.reserve(m_positions.size());
+        z.reserve(m_positions.size());
+        gains.reserve(m_positions.size());
+        for (auto& pair : m_positions) {
+            channels.push_back(pair.first);
+            x.push_back(pair.second.x);
+            y.push_back(pair.second.y);
+            z.push_back(pair.second.z);
+            gains.push_back(getCalibration(pair.first));
+        }
+        if (m_session->setPannerChannels(m_panner, channels, x, y, z, gains) != SyntactsError_NoError)
+            return;
+        m_dirty = false;
+    }
+    Panning panning;
+    panning.x       = m_target.x;
+    panning.y       = m_target.y;
+    panning.z       = m_target.z;
+    panning.radius  = m_radius;
+    panning.kernelX = m_kernel.x;
+    panning.kernelY = m_kernel.y;
+    panning.kernelZ = m_kernel.z;
+    panning.nearest = m_nearest;
+    panning.volume  = m_volume;
+    panning.wrapX   = m_wrapInterval.x;
+    panning.wrapY   = m_wrapInterval.y;
+    panning.rollOff = m_rollOff;
+    if (time < 0)
+        m_session->setPanning(m_panner, panning);
+    else
+        m_session->setPanning(m_panner, panning, time);
+    // trajectories are sent once and then evaluated by the Session
+    if (m_moving && !m_motionSent) {
+        if (time < 0)
+            m_session->setTrajectory(m_panner, m_trajectory);
+        else
+            m_session->setTrajectory(m_panner, m_trajectory, time);
+        m_motionSent = true;
+    }
+    // sources are only sent when they change
+    for (auto& pair : m_sources) {
+        auto& s = pair.second;
+        if (s.dirty) {
+            panning.x       = s.position.x;
+            panning.y       = s.position.y;
+            panning.z       = s.position.z;
+            panning.radius  = s.radius;
+            panning.volume  = s.volume * m_volume;
+            panning.rollOff = s.rollOff;
+            if (time < 0)
+                m_session->setSourcePanning(m_panner, pair.first, panning);
+            else
+                m_session->setSourcePanning(m_panner, pair.first, panning, time);
+            s.dirty = false;
+        }
+        if (s.moving && !s.motionSent) {
+            if (time < 0)
+                m_session->setSourceTrajectory(m_panner, pair.first, s.trajectory);
+            else
+                m_session->setSourceTrajectory(m_panner, pair.first, s.trajectory, time);
+            s.motionSent = true;
+        }
+        if (s.playing && !s.started) {
+            m_session->playSource(m_panner, pair.first, s.signal);
+            s.started = true;
+        }
     }
 }
 }
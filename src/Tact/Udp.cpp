@@ -0,0 +1,669 @@
+#include <Tact/Udp.hpp>
+#include <Tact/Library.hpp>
+#include "Tact/LibraryCache.hpp"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <sys/socket.h>
+    #include <sys/select.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <unistd.h>
+#endif
+
+namespace tact {
+
+///////////////////////////////////////////////////////////////////////////////
+// PROTOCOL
+///////////////////////////////////////////////////////////////////////////////
+
+// Datagrams are little-endian: a 20 byte header followed by count messages.
+//
+//   header:       u32 magic | u16 version | u16 count | u32 sequence | f64 time
+//   Play:         u8 op | u16 channel | u32 size | size bytes (Library::encodeSignal)
+//   PlayLibrary:  u8 op | u16 channel | u16 size | size bytes (name)
+//   Stop/Pause/Resume: u8 op | u16 channel
+//   StopAll:      u8 op
+//   SetVolume/SetPitch: u8 op | u16 channel | f32 value
+//   SetTarget:    u8 op | u16 spatializer | f32 x | f32 y
+//   Ping/Pong:    u8 op | u32 id | f64 sender time
+
+namespace {
+
+constexpr std::uint32_t UDP_MAGIC    = 0x44555453; // "STUD"
+constexpr std::uint16_t UDP_VERSION  = 1;
+constexpr std::size_t   HEADER_SIZE  = 20;
+constexpr std::size_t   BATCH_SIZE   = 1400;  // keeps batches within a single Ethernet frame
+constexpr std::size_t   MAX_DATAGRAM = 65507;
+constexpr double        SYNC_WINDOW  = 2.0;   // seconds over which the sender clock offset is re-estimated
+
+enum UdpOp : std::uint8_t {
+    UdpPlay        = 0,
+    UdpPlayLibrary = 1,
+    UdpStop        = 2,
+    UdpStopAll     = 3,
+    UdpPause       = 4,
+    UdpResume      = 5,
+    UdpSetVolume   = 6,
+    UdpSetPitch    = 7,
+    UdpSetTarget   = 8,
+    UdpPing        = 9,
+    UdpPong        = 10
+};
+
+#ifdef _WIN32
+using socket_t = SOCKET;
+constexpr socket_t NO_SOCKET = INVALID_SOCKET;
+inline void closeSocket(socket_t s) { closesocket(s); }
+#else
+using socket_t = int;
+constexpr socket_t NO_SOCKET = -1;
+inline void closeSocket(socket_t s) { ::close(s); }
+#endif
+
+/// Initializes the platform socket library for its lifetime
+struct SocketLibrary {
+    SocketLibrary() {
+#ifdef _WIN32
+        WSADATA data;
+        WSAStartup(MAKEWORD(2, 2), &data);
+#endif
+    }
+    ~SocketLibrary() {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+};
+
+/// Waits up to timeout seconds for a socket to become readable
+bool waitReadable(socket_t s, double timeout) {
+    fd_set set;
+    FD_ZERO(&set);
+    FD_SET(s, &set);
+    timeval tv;
+    tv.tv_sec  = static_cast<long>(timeout);
+    tv.tv_usec = static_cast<long>((timeout - tv.tv_sec) * 1000000);
+    return select(static_cast<int>(s) + 1, &set, nullptr, nullptr, &tv) > 0;
+}
+
+/// Appends little-endian values to a datagram
+struct Writer {
+    std::string& buffer;
+    template <typename T>
+    void write(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        buffer.append(bytes, sizeof(T));
+    }
+    void write(const char* data, std::size_t size) {
+        buffer.append(data, size);
+    }
+};
+
+/// Bounds checked reader of little-endian values from a datagram
+struct Reader {
+    const char* p;
+    const char* end;
+    bool ok = true;
+    template <typename T>
+    T read() {
+        T value{};
+        if (end - p < static_cast<std::ptrdiff_t>(sizeof(T))) {
+            ok = false;
+            return value;
+        }
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+    const char* skip(std::size_t size) {
+        if (static_cast<std::size_t>(end - p) < size) {
+            ok = false;
+            return nullptr;
+        }
+        const char* data = p;
+        p += size;
+        return data;
+    }
+};
+
+void writeHeader(std::string& buffer, std::uint16_t count, std::uint32_t sequence, double time) {
+    buffer.clear();
+    Writer w{buffer};
+    w.write(UDP_MAGIC);
+    w.write(UDP_VERSION);
+    w.write(count);
+    w.write(sequence);
+    w.write(time);
+}
+
+/// Estimates the offset between a sender's clock and the Session clock
+struct ClockSync {
+    bool   initialized = false;
+    double offset      = 0; ///< Session time minus sender time (includes minimum network delay)
+    double windowMin   = 0;
+    double windowStart = 0;
+    void update(double observed, double now) {
+        if (!initialized) {
+            offset = windowMin = observed;
+            windowStart = now;
+            initialized = true;
+            return;
+        }
+        offset    = std::min(offset, observed);
+        windowMin = std::min(windowMin, observed);
+        // forget old minima so clock drift is tracked
+        if (now - windowStart > SYNC_WINDOW) {
+            offset      = windowMin;
+            windowMin   = observed;
+            windowStart = now;
+        }
+    }
+};
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// SERVER
+///////////////////////////////////////////////////////////////////////////////
+
+class UdpServer::Impl {
+public:
+
+    Impl(Session& session, int port, const std::string& address) :
+        m_session(session), m_port(port), m_address(address), m_socket(NO_SOCKET), m_running(false), 
+        m_latency(0.005), m_messages(0), m_datagrams(0)
+    { }
+
+    ~Impl() {
+        stop();
+    }
+
+    int start() {
+        if (m_running)
+            return SyntactsError_NoError;
+        if (!m_session.isOpen())
+            return SyntactsError_NotOpen;
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port   = htons(static_cast<std::uint16_t>(m_port));
+        if (inet_pton(AF_INET, m_address.c_str(), &addr.sin_addr) != 1)
+            return SyntactsError_NotSupported;
+        m_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (m_socket == NO_SOCKET)
+            return SyntactsError_NotSupported;
+        int size = 4 * 1024 * 1024;
+        setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&size), sizeof(size));
+        if (bind(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            std::cout << "Failed to bind UDP " << m_address << ":" << m_port << std::endl;
+            closeSocket(m_socket);
+            m_socket = NO_SOCKET;
+            return SyntactsError_NotSupported;
+        }
+        m_messages  = 0;
+        m_datagrams = 0;
+        m_clocks.clear();
+        m_running = true;
+        m_thread = std::thread(&Impl::receive, this);
+        return SyntactsError_NoError;
+    }
+
+    void stop() {
+        if (!m_running)
+            return;
+        m_running = false;
+        if (m_thread.joinable())
+            m_thread.join();
+        closeSocket(m_socket);
+        m_socket = NO_SOCKET;
+        m_library.clear();
+    }
+
+    void receive() {
+        std::vector<char> buffer(MAX_DATAGRAM);
+        while (m_running) {
+            if (!waitReadable(m_socket, 0.1))
+                continue;
+            sockaddr_in from{};
+            socklen_t fromLength = sizeof(from);
+            int n = recvfrom(m_socket, buffer.data(), static_cast<int>(buffer.size()), 0, reinterpret_cast<sockaddr*>(&from), &fromLength);
+            if (n <= 0)
+                continue;
+            m_datagrams.fetch_add(1, std::memory_order_relaxed);
+            process(buffer.data(), static_cast<std::size_t>(n), from);
+        }
+    }
+
+    /// Returns true if a channel exists on the Session (invalid channels are skipped without decoding)
+    bool validChannel(int channel) const {
+        return channel < m_session.getChannelCount();
+    }
+
+    void process(const char* data, std::size_t size, const sockaddr_in& from) {
+        Reader r{data, data + size};
+        auto magic    = r.read<std::uint32_t>();
+        auto version  = r.read<std::uint16_t>();
+        auto count    = r.read<std::uint16_t>();
+        auto sequence = r.read<std::uint32_t>();
+        auto sent     = r.read<double>();
+        (void)sequence;
+        if (!r.ok || magic != UDP_MAGIC || version != UDP_VERSION)
+            return;
+        // map the sender timestamp to Session time (negative times are applied immediately)
+        double time = -1;
+        if (sent > 0) {
+            double now = m_session.getTime();
+            std::uint64_t key = (static_cast<std::uint64_t>(from.sin_addr.s_addr) << 16) | from.sin_port;
+            auto& clock = m_clocks[key];
+            clock.update(now - sent, now);
+            time = sent + clock.offset + m_latency.load();
+        }
+        std::size_t applied = 0;
+        for (std::uint16_t i = 0; i < count && r.ok; ++i) {
+            auto op = r.read<std::uint8_t>();
+            switch (op) {
+                case UdpPlay: {
+                    int channel = r.read<std::uint16_t>();
+                    auto length = r.read<std::uint32_t>();
+                    const char* bytes = r.skip(length);
+                    Signal signal;
+                    if (r.ok && validChannel(channel) && Library::decodeSignal(signal, bytes, length))
+                        m_session.play(channel, std::move(signal), time);
+                    break;
+                }
+                case UdpPlayLibrary: {
+                    int channel = r.read<std::uint16_t>();
+                    auto length = r.read<std::uint16_t>();
+                    const char* bytes = r.skip(length);
+                    if (!r.ok || !validChannel(channel))
+                        break;
+                    const Signal* signal = m_library.get(std::string(bytes, length));
+                    if (signal)
+                        m_session.play(channel, *signal, time);
+                    break;
+                }
+                case UdpStop: {
+                    int channel = r.read<std::uint16_t>();
+                    if (r.ok && validChannel(channel))
+                        m_session.stop(channel, time);
+                    break;
+                }
+                case UdpStopAll: {
+                    for (int c = 0; c < m_session.getChannelCount(); ++c)
+                        m_session.stop(c, time);
+                    break;
+                }
+                case UdpPause:
+                case UdpResume: {
+                    int channel = r.read<std::uint16_t>();
+                    if (!r.ok || !validChannel(channel))
+                        break;
+                    if (op == UdpPause)
+                        m_session.pause(channel, time);
+                    else
+                        m_session.resume(channel, time);
+                    break;
+                }
+                case UdpSetVolume: {
+                    int channel = r.read<std::uint16_t>();
+                    float value = r.read<float>();
+                    if (r.ok && validChannel(channel))
+                        m_session.setVolume(channel, value, time);
+                    break;
+                }
+                case UdpSetPitch: {
+                    int channel = r.read<std::uint16_t>();
+                    float value = r.read<float>();
+                    if (r.ok && validChannel(channel))
+                        m_session.setPitch(channel, value, time);
+                    break;
+                }
+                case UdpSetTarget: {
+                    int id  = r.read<std::uint16_t>();
+                    float x = r.read<float>();
+                    float y = r.read<float>();
+                    if (!r.ok)
+                        break;
+                    std::lock_guard<std::mutex> lock(m_spatializerMutex);
+                    auto it = m_spatializers.find(id);
+                    if (it != m_spatializers.end()) {
+                        it->second->setTarget(x, y);
+                        it->second->update(time);
+                    }
+                    break;
+                }
+                case UdpPing: {
+                    auto id   = r.read<std::uint32_t>();
+                    auto echo = r.read<double>();
+                    if (r.ok)
+                        pong(from, id, echo);
+                    break;
+                }
+                default:
+                    r.ok = false; // unknown op, the rest of the datagram can't be parsed
+                    break;
+            }
+            if (r.ok)
+                applied++;
+        }
+        m_messages.fetch_add(applied, std::memory_order_relaxed);
+    }
+
+    void pong(const sockaddr_in& to, std::uint32_t id, double echo) {
+        writeHeader(m_reply, 1, 0, m_session.getTime());
+        Writer w{m_reply};
+        w.write(static_cast<std::uint8_t>(UdpPong));
+        w.write(id);
+        w.write(echo);
+        sendto(m_socket, m_reply.data(), static_cast<int>(m_reply.size()), 0, reinterpret_cast<const sockaddr*>(&to), sizeof(to));
+    }
+
+    SocketLibrary m_socketLibrary;
+    Session& m_session;
+    int m_port;
+    std::string m_address;
+    socket_t m_socket;
+    std::atomic<bool> m_running;
+    std::atomic<double> m_latency;
+    std::atomic<std::size_t> m_messages;
+    std::atomic<std::size_t> m_datagrams;
+    std::thread m_thread;
+    std::unordered_map<std::uint64_t, ClockSync> m_clocks;
+    std::mutex m_spatializerMutex;
+    std::unordered_map<int, Spatializer*> m_spatializers;
+    LibraryCache m_library;
+    std::string m_reply;
+};
+
+UdpServer::UdpServer(Session& session, int port, const std::string& address) :
+    m_impl(std::make_unique<UdpServer::Impl>(session, port, address))
+{ }
+
+UdpServer::~UdpServer() { }
+
+int UdpServer::start() {
+    return m_impl->start();
+}
+
+void UdpServer::stop() {
+    m_impl->stop();
+}
+
+bool UdpServer::isRunning() const {
+    return m_impl->m_running;
+}
+
+const std::string& UdpServer::getAddress() const {
+    return m_impl->m_address;
+}
+
+void UdpServer::setLatency(double latency) {
+    m_impl->m_latency = std::max(0.0, latency);
+}
+
+double UdpServer::getLatency() const {
+    return m_impl->m_latency;
+}
+
+void UdpServer::addSpatializer(int id, Spatializer& spatializer) {
+    spatializer.autoUpdate(false);
+    std::lock_guard<std::mutex> lock(m_impl->m_spatializerMutex);
+    m_impl->m_spatializers[id] = &spatializer;
+}
+
+void UdpServer::removeSpatializer(int id) {
+    std::lock_guard<std::mutex> lock(m_impl->m_spatializerMutex);
+    m_impl->m_spatializers.erase(id);
+}
+
+std::size_t UdpServer::getMessageCount() const {
+    return m_impl->m_messages.load(std::memory_order_relaxed);
+}
+
+std::size_t UdpServer::getDatagramCount() const {
+    return m_impl->m_datagrams.load(std::memory_order_relaxed);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// CLIENT
+///////////////////////////////////////////////////////////////////////////////
+
+class UdpClient::Impl {
+public:
+
+    Impl() : m_socket(NO_SOCKET), m_count(0), m_sequence(0), m_time(0) { 
+        writeHeader(m_batch, 0, 0, 0);
+    }
+
+    ~Impl() {
+        disconnect();
+    }
+
+    int connect(const std::string& address, int port) {
+        disconnect();
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port   = htons(static_cast<std::uint16_t>(port));
+        if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1)
+            return SyntactsError_NotConnected;
+        m_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (m_socket == NO_SOCKET)
+            return SyntactsError_NotSupported;
+        // connecting a UDP socket just fixes the destination (and filters replies)
+        if (::connect(m_socket, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            disconnect();
+            return SyntactsError_NotConnected;
+        }
+        return SyntactsError_NoError;
+    }
+
+    void disconnect() {
+        if (m_socket != NO_SOCKET)
+            closeSocket(m_socket);
+        m_socket = NO_SOCKET;
+        m_count = 0;
+        writeHeader(m_batch, 0, 0, 0);
+    }
+
+    /// Begins a message of size bytes, sending the current batch first if it would overflow
+    int begin(std::size_t size) {
+        if (m_socket == NO_SOCKET)
+            return SyntactsError_NotConnected;
+        if (HEADER_SIZE + size > MAX_DATAGRAM)
+            return SyntactsError_SignalTooLarge;
+        if (m_count > 0 && (m_batch.size() + size > BATCH_SIZE || m_count == std::numeric_limits<std::uint16_t>::max())) {
+            int result = send();
+            if (result != SyntactsError_NoError)
+                return result;
+        }
+        m_count++;
+        return SyntactsError_NoError;
+    }
+
+    int channelOp(UdpOp op, int channel) {
+        if (int result = begin(3))
+            return result;
+        Writer w{m_batch};
+        w.write(static_cast<std::uint8_t>(op));
+        w.write(static_cast<std::uint16_t>(channel));
+        return SyntactsError_NoError;
+    }
+
+    int valueOp(UdpOp op, int channel, double value) {
+        if (int result = begin(7))
+            return result;
+        Writer w{m_batch};
+        w.write(static_cast<std::uint8_t>(op));
+        w.write(static_cast<std::uint16_t>(channel));
+        w.write(static_cast<float>(value));
+        return SyntactsError_NoError;
+    }
+
+    int send() {
+        if (m_socket == NO_SOCKET)
+            return SyntactsError_NotConnected;
+        if (m_count == 0)
+            return SyntactsError_NoError;
+        // patch count, sequence and time into the header
+        std::uint32_t sequence = m_sequence++;
+        std::memcpy(&m_batch[6], &m_count, sizeof(m_count));
+        std::memcpy(&m_batch[8], &sequence, sizeof(sequence));
+        std::memcpy(&m_batch[12], &m_time, sizeof(m_time));
+        int n = ::send(m_socket, m_batch.data(), static_cast<int>(m_batch.size()), 0);
+        m_count = 0;
+        m_batch.resize(HEADER_SIZE);
+        return n < 0 ? SyntactsError_NotConnected : SyntactsError_NoError;
+    }
+
+    socket_t m_socket;
+    std::string m_batch;
+    std::string m_signal;
+    std::uint16_t m_count;
+    std::uint32_t m_sequence;
+    double m_time;
+    SocketLibrary m_socketLibrary;
+};
+
+UdpClient::UdpClient() :
+    m_impl(std::make_unique<UdpClient::Impl>())
+{ }
+
+UdpClient::~UdpClient() { }
+
+int UdpClient::connect(const std::string& address, int port) {
+    return m_impl->connect(address, port);
+}
+
+void UdpClient::disconnect() {
+    m_impl->disconnect();
+}
+
+bool UdpClient::isConnected() const {
+    return m_impl->m_socket != NO_SOCKET;
+}
+
+void UdpClient::setTime(double time) {
+    m_impl->m_time = time;
+}
+
+int UdpClient::play(int channel, const Signal& signal) {
+    if (!Library::encodeSignal(signal, m_impl->m_signal))
+        return SyntactsError_NoWaveform;
+    if (int result = m_impl->begin(7 + m_impl->m_signal.size()))
+        return result;
+    Writer w{m_impl->m_batch};
+    w.write(static_cast<std::uint8_t>(UdpPlay));
+    w.write(static_cast<std::uint16_t>(channel));
+    w.write(static_cast<std::uint32_t>(m_impl->m_signal.size()));
+    w.write(m_impl->m_signal.data(), m_impl->m_signal.size());
+    return SyntactsError_NoError;
+}
+
+int UdpClient::playLibrary(int channel, const std::string& name) {
+    if (name.size() > std::numeric_limits<std::uint16_t>::max())
+        return SyntactsError_SignalTooLarge;
+    if (int result = m_impl->begin(5 + name.size()))
+        return result;
+    Writer w{m_impl->m_batch};
+    w.write(static_cast<std::uint8_t>(UdpPlayLibrary));
+    w.write(static_cast<std::uint16_t>(channel));
+    w.write(static_cast<std::uint16_t>(name.size()));
+    w.write(name.data(), name.size());
+    return SyntactsError_NoError;
+}
+
+int UdpClient::stop(int channel) {
+    return m_impl->channelOp(UdpStop, channel);
+}
+
+int UdpClient::stopAll() {
+    if (int result = m_impl->begin(1))
+        return result;
+    Writer w{m_impl->m_batch};
+    w.write(static_cast<std::uint8_t>(UdpStopAll));
+    return SyntactsError_NoError;
+}
+
+int UdpClient::pause(int channel) {
+    return m_impl->channelOp(UdpPause, channel);
+}
+
+int UdpClient::resume(int channel) {
+    return m_impl->channelOp(UdpResume, channel);
+}
+
+int UdpClient::setVolume(int channel, double volume) {
+    return m_impl->valueOp(UdpSetVolume, channel, volume);
+}
+
+int UdpClient::setPitch(int channel, double pitch) {
+    return m_impl->valueOp(UdpSetPitch, channel, pitch);
+}
+
+int UdpClient::setTarget(int spatializer, double x, double y) {
+    if (int result = m_impl->begin(11))
+        return result;
+    Writer w{m_impl->m_batch};
+    w.write(static_cast<std::uint8_t>(UdpSetTarget));
+    w.write(static_cast<std::uint16_t>(spatializer));
+    w.write(static_cast<float>(x));
+    w.write(static_cast<float>(y));
+    return SyntactsError_NoError;
+}
+
+int UdpClient::ping(std::uint32_t id) {
+    if (int result = m_impl->begin(13))
+        return result;
+    Writer w{m_impl->m_batch};
+    w.write(static_cast<std::uint8_t>(UdpPing));
+    w.write(id);
+    w.write(now());
+    return SyntactsError_NoError;
+}
+
+int UdpClient::send() {
+    return m_impl->send();
+}
+
+bool UdpClient::receivePong(std::uint32_t& id, double& roundTrip, double timeout) {
+    if (m_impl->m_socket == NO_SOCKET)
+        return false;
+    char buffer[64];
+    double deadline = now() + timeout;
+    for (double left = timeout; left > 0; left = deadline - now()) {
+        if (!waitReadable(m_impl->m_socket, left))
+            return false;
+        int n = recv(m_impl->m_socket, buffer, sizeof(buffer), 0);
+        if (n <= 0)
+            continue;
+        Reader r{buffer, buffer + n};
+        auto magic = r.read<std::uint32_t>();
+        r.skip(HEADER_SIZE - sizeof(magic));
+        auto op    = r.read<std::uint8_t>();
+        auto pid   = r.read<std::uint32_t>();
+        auto echo  = r.read<double>();
+        if (r.ok && magic == UDP_MAGIC && op == UdpPong) {
+            id = pid;
+            roundTrip = now() - echo;
+            return true;
+        }
+    }
+    return false;
+}
+
+double UdpClient::now() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace tact
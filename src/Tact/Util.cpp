@@ -37,6 +37,9 @@ const std::string& signalName(const Signal& signal) {
         {typeid(Time),             "Time"},
         {typeid(Ramp),             "Ramp"},
         {typeid(Noise),            "Noise"},
+        {typeid(PinkNoise),        "Pink Noise"},
+        {typeid(BrownNoise),       "Brown Noise"},
+        {typeid(BandNoise),        "Band Noise"},
         {typeid(Expression),       "Expression"},
         {typeid(PolyBezier),       "PolyBezier"},
         {typeid(Samples),          "Samples"},
@@ -45,12 +48,18 @@ const std::string& signalName(const Signal& signal) {
         {typeid(Product),          "Product"},
         // Sequence.hpp  
         {typeid(Sequence),         "Sequence"},
+        {typeid(SequenceRef),      "Sequence Reference"},
         // Oscillator.hpp
         {typeid(Sine),             "Sine"},
         {typeid(Square),           "Square"},
         {typeid(Saw),              "Saw"},
         {typeid(Triangle),         "Triangle"},
         {typeid(Pwm),              "PWM"},
+        {typeid(ChirpPhase),       "Chirp Phase"},
+        {typeid(FmPhase),          "FM Phase"},
+        {typeid(Chirp),            "Chirp"},
+        {typeid(FmSine),           "FM Sine"},
+        {typeid(Wavetable),        "Wavetable"},
         // Envelope.hpp
         {typeid(Envelope),         "Envelope"},
         {typeid(KeyedEnvelope),    "Keyed Envelope"},
@@ -68,44 +77,56 @@ const std::string& signalName(const Signal& signal) {
         return unkown;
 }
 
-void recurseSignalPriv(const Signal& sig, std::function<void(const Signal&, int depth)> func, int depth) {
+void recurseSignalPriv(const Signal& sig, std::function<void(const Signal&, int depth)> func, int depth, bool shared) {
     auto id = sig.typeId();
     func(sig, depth);
     if (id == typeid(Sum)) {
-        recurseSignalPriv(sig.getAs<Sum>()->lhs,func,depth+1);
-        recurseSignalPriv(sig.getAs<Sum>()->rhs,func,depth+1);
+        recurseSignalPriv(sig.getAs<Sum>()->lhs,func,depth+1,shared);
+        recurseSignalPriv(sig.getAs<Sum>()->rhs,func,depth+1,shared);
     }
     else if (id == typeid(Product)) {
-        recurseSignalPriv(sig.getAs<Product>()->lhs,func,depth+1);
-        recurseSignalPriv(sig.getAs<Product>()->rhs,func,depth+1);
+        recurseSignalPriv(sig.getAs<Product>()->lhs,func,depth+1,shared);
+        recurseSignalPriv(sig.getAs<Product>()->rhs,func,depth+1,shared);
     }
     else if (id == typeid(Sequence)) {
         auto seq = sig.getAs<Sequence>();
         int K = seq->keyCount();
         for (int k = 0; k < K; ++k)
-            recurseSignalPriv(seq->getKey(k).signal,func,depth+1);
+            recurseSignalPriv(seq->getKey(k).signal,func,depth+1,shared);
+    }
+    else if (id == typeid(SequenceRef) && shared) {
+        auto& seq = sig.getAs<SequenceRef>()->get();
+        int K = seq.keyCount();
+        for (int k = 0; k < K; ++k)
+            recurseSignalPriv(seq.getKey(k).signal,func,depth+1,shared);
     }
     else if (id == typeid(Repeater))
-        recurseSignalPriv(sig.getAs<Repeater>()->signal,func,depth+1);
+        recurseSignalPriv(sig.getAs<Repeater>()->signal,func,depth+1,shared);
     else if (id == typeid(Stretcher))
-        recurseSignalPriv(sig.getAs<Stretcher>()->signal,func,depth+1);
+        recurseSignalPriv(sig.getAs<Stretcher>()->signal,func,depth+1,shared);
     else if (id == typeid(Reverser))
-        recurseSignalPriv(sig.getAs<Reverser>()->signal,func,depth+1);   
+        recurseSignalPriv(sig.getAs<Reverser>()->signal,func,depth+1,shared);   
+    else if (id == typeid(ControlRate))
+        recurseSignalPriv(sig.getAs<ControlRate>()->signal,func,depth+1,shared);
     else if (id == typeid(Sine))
-         recurseSignalPriv(sig.getAs<Sine>()->x,func,depth+1);
+         recurseSignalPriv(sig.getAs<Sine>()->x,func,depth+1,shared);
     else if (id == typeid(Square))
-         recurseSignalPriv(sig.getAs<Square>()->x,func,depth+1);
+         recurseSignalPriv(sig.getAs<Square>()->x,func,depth+1,shared);
     else if (id == typeid(Saw))
-         recurseSignalPriv(sig.getAs<Saw>()->x,func,depth+1);
+         recurseSignalPriv(sig.getAs<Saw>()->x,func,depth+1,shared);
     else if (id == typeid(Triangle))
-         recurseSignalPriv(sig.getAs<Triangle>()->x,func,depth+1);
+         recurseSignalPriv(sig.getAs<Triangle>()->x,func,depth+1,shared);
+    else if (id == typeid(Wavetable))
+         recurseSignalPriv(sig.getAs<Wavetable>()->x,func,depth+1,shared);
+    else if (id == typeid(FmPhase))
+         recurseSignalPriv(sig.getAs<FmPhase>()->modulation,func,depth+1,shared);
     else if (id == typeid(SignalEnvelope))
-         recurseSignalPriv(sig.getAs<SignalEnvelope>()->signal,func,depth+1);
+         recurseSignalPriv(sig.getAs<SignalEnvelope>()->signal,func,depth+1,shared);
 }
 
 /// Recurse a signal for embedded signals and calls func on each
-void recurseSignal(const Signal& signal, std::function<void(const Signal&, int depth)> func) {
-    recurseSignalPriv(signal, func, 0);
+void recurseSignal(const Signal& signal, std::function<void(const Signal&, int depth)> func, bool shared) {
+    recurseSignalPriv(signal, func, 0, shared);
 }
 
 const std::string& syntactsVersion() {
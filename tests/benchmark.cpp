@@ -50,6 +50,19 @@ int main(int argc, char const *argv[])
         sum += sig.sample(t);
     }
     display(toc(), n, sum, "Expression");
+
+    Expression expr("sin(2*pi*175*t+2*sin(2*pi*10*t))");
+    std::vector<double> tBlock(bufferSize), eBlock(bufferSize);
+    sum = 0;
+    tic();
+    for (int i = 0; i < n; i += bufferSize) {
+        for (int j = 0; j < bufferSize; ++j)
+            tBlock[j] = (i + j) * lenN;
+        expr.sample(tBlock.data(), eBlock.data(), bufferSize);
+        for (int j = 0; j < bufferSize; ++j)
+            sum += eBlock[j] * env.sample(tBlock[j]);
+    }
+    display(toc(), n, sum, "Expression (Block)");
    
     sum = 0;
     tic();
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <syntacts>
+#include <iostream>
+#include <string>
+#include <cmath>
+
+// Helpers shared by the benchmarks
+
+/// Frames per block rendered by the benchmarks, as the Session renders them.
+constexpr int BENCHMARK_BLOCK = 256;
+
+/// Prints the time and rate of n benchmark iterations, and how many times realtime they run if realtime is given (in iterations per second).
+inline void display(double t, int n, double sum, const std::string& benchmark, double realtime = 0) {
+    std::cout << std::endl;
+    std::cout << " Benchmark: " << benchmark << std::endl;
+    std::cout << " Time:      " << t << " s" << std::endl;
+    std::cout << " Frequency: " << n / t / 1000 << " kHz" << std::endl;
+    if (realtime > 0)
+        std::cout << " Realtime:  " << (n / t) / realtime << "x" << std::endl;
+    std::cout << " Sum:       " << sum << std::endl;
+}
+
+/// Samples n frames of a Signal at 48 kHz in blocks and returns the sum of each block's first sample. Times wrap every period seconds.
+inline double render(const tact::Signal& signal, int n, double period = tact::INF) {
+    double t[BENCHMARK_BLOCK], b[BENCHMARK_BLOCK];
+    double sum = 0;
+    for (int i = 0; i < n; i += BENCHMARK_BLOCK) {
+        for (int j = 0; j < BENCHMARK_BLOCK; ++j)
+            t[j] = period < tact::INF ? std::fmod((i + j) / 48000.0, period) : (i + j) / 48000.0;
+        signal.sample(t, b, BENCHMARK_BLOCK);
+        sum += b[0];
+    }
+    return sum;
+}
@@ -0,0 +1,52 @@
+#include "benchmark.hpp"
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace tact;
+
+// Samples a Sine carrier under an ADSR with curved segments and under a slow LFO, in 256 frame
+// blocks as the Session renders them, once at the audio rate and once with the envelope and LFO
+// evaluated at a 1 kHz control rate and interpolated (as RealTime::controlRate does automatically).
+
+double maxError(const Signal& a, const Signal& b) {
+    std::vector<double> t(48000), x(48000), y(48000);
+    for (int i = 0; i < 48000; ++i)
+        t[i] = i / 48000.0;
+    a.sample(t.data(), x.data(), 48000);
+    b.sample(t.data(), y.data(), 48000);
+    double e = 0;
+    for (int i = 0; i < 48000; ++i)
+        e = std::max(e, std::abs(x[i] - y[i]));
+    return e;
+}
+
+int main()
+{
+    const int n = 48000 * 60;
+
+    ADSR adsr(0.1, 0.2, 0.5, 0.2, 1.0, 0.5, Curves::Smoothstep(), Curves::Exponential::Out(), Curves::Smootherstep());
+    Signal audio   = Sine(175) * adsr;
+    Signal control = Sine(175) * ControlRate(adsr, 1000);
+
+    tic();
+    double sum = render(audio, n, 1.0);
+    display(toc(), n, sum, "ADSR Audio Rate", 48000);
+    tic();
+    sum = render(control, n, 1.0);
+    display(toc(), n, sum, "ADSR Control Rate", 48000);
+    std::cout << " Max Error: " << maxError(audio, control) << std::endl;
+
+    audio   = Sine(175) * (0.5 + 0.5 * Sine(2));
+    control = Sine(175) * (0.5 + 0.5 * ControlRate(Sine(2), 1000));
+
+    tic();
+    sum = render(audio, n, 1.0);
+    display(toc(), n, sum, "LFO Audio Rate", 48000);
+    tic();
+    sum = render(control, n, 1.0);
+    display(toc(), n, sum, "LFO Control Rate", 48000);
+    std::cout << " Max Error: " << maxError(audio, control) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include "benchmark.hpp"
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace tact;
+
+// Queries the length of a deep Signal graph (a Sum of 32 enveloped Sines, repeated and stretched)
+// and streams the graph through an unbaked Repeater, which needs its input's length every sample.
+
+int main()
+{
+    Signal chain = Sine(100) * ASR(0, 0.1, 0.1);
+    for (int i = 1; i < 32; ++i)
+        chain = chain + Sine(100 + 10 * i) * ASR(0.01 * i, 0.1, 0.1);
+    Signal graph = Stretcher(Repeater(chain, 4, 0.05), 1.5);
+
+    const int queries = 10000000;
+    tic();
+    double sum = 0;
+    for (int i = 0; i < queries; ++i)
+        sum += graph.length();
+    display(toc(), queries, sum, "Length");
+
+    const int n = 48000 * 10;
+    Signal repeater = Repeater(chain, 1000, 0.05);
+    tic();
+    sum = 0;
+    for (int i = 0; i < n; ++i)
+        sum += repeater.sample(i / 48000.0);
+    display(toc(), n, sum, "Repeater");
+
+    std::cout << std::endl;
+    std::cout << " Peak:      " << graph.peak() << std::endl;
+
+    return 0;
+}
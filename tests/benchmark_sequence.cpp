@@ -0,0 +1,126 @@
+#include "benchmark.hpp"
+#include <iostream>
+#include <random>
+
+using namespace tact;
+
+// Samples a 10k-key, two minute Sequence by streaming playback (one sample and one block at a
+// time) and by random access, and compares against the old approach of scanning every key on
+// every sample. Then streams a sparse Sequence that is mostly gaps.
+
+double naiveSample(const Sequence& seq, double t) {
+    double sample = 0;
+    for (int i = 0; i < seq.keyCount(); ++i) {
+        auto& k = seq.getKey(i);
+        if (t >= k.t && t <= k.t + k.signal.length())
+            sample += k.signal.sample(t - k.t);
+    }
+    return sample;
+}
+
+int main()
+{
+    const int keys = 10000;
+    const double fs = 48000;
+    volatile double sum = 0;
+
+    // 10k short bursts with overlap, inserted out of order
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> start(0, 120);
+    Sequence seq;
+    tic();
+    for (int i = 0; i < keys; ++i)
+        seq.insert(Sine(175 + i % 100) * ASR(0.005, 0.01, 0.005), start(rng));
+    std::cout << std::endl << " Built " << seq.keyCount() << " keys in " << toc() << " s (" << seq.length() << " s long)" << std::endl;
+
+    int n = static_cast<int>(seq.length() * fs);
+    sum = 0;
+    tic();
+    for (int i = 0; i < n; ++i)
+        sum += seq.sample(i / fs);
+    display(toc(), n, sum, "Streaming", fs);
+
+    // the Session renders voices in blocks, which samples each key as a block and skips gaps
+    std::vector<double> tBlock(256), bBlock(256);
+    sum = 0;
+    tic();
+    for (int i = 0; i + 256 <= n; i += 256) {
+        for (int j = 0; j < 256; ++j)
+            tBlock[j] = (i + j) / fs;
+        seq.sample(tBlock.data(), bBlock.data(), 256);
+        for (int j = 0; j < 256; ++j)
+            sum += bBlock[j];
+    }
+    display(toc(), n, sum, "Streaming (Blocks)", fs);
+
+    // 100 short bursts a second apart, so most blocks fall in gaps
+    Sequence sparse;
+    for (int i = 0; i < 100; ++i)
+        sparse.insert(Sine(175) * ASR(0.01, 0.05, 0.01), i * 1.2);
+    int ns = static_cast<int>(sparse.length() * fs);
+    sum = 0;
+    tic();
+    for (int i = 0; i < ns; ++i)
+        sum += sparse.sample(i / fs);
+    display(toc(), ns, sum, "Sparse", fs);
+    sum = 0;
+    tic();
+    for (int i = 0; i + 256 <= ns; i += 256) {
+        for (int j = 0; j < 256; ++j)
+            tBlock[j] = (i + j) / fs;
+        sparse.sample(tBlock.data(), bBlock.data(), 256);
+        for (int j = 0; j < 256; ++j)
+            sum += bBlock[j];
+    }
+    display(toc(), ns, sum, "Sparse (Blocks)", fs);
+
+    std::vector<double> times(1000000);
+    for (auto& t : times)
+        t = start(rng);
+    sum = 0;
+    tic();
+    for (auto& t : times)
+        sum += seq.sample(t);
+    display(toc(), (int)times.size(), sum, "Random Access", fs);
+
+    // the naive scan is orders of magnitude slower, so only sample one second of it
+    int m = static_cast<int>(fs);
+    sum = 0;
+    tic();
+    for (int i = 0; i < m; ++i)
+        sum += naiveSample(seq, i / fs);
+    display(toc(), m, sum, "Naive Scan", fs);
+
+    sum = 0;
+    for (int i = 0; i < m; ++i)
+        sum += seq.sample(i / fs);
+    std::cout << " Indexed:   " << sum << std::endl;
+
+    // composing a pattern library: 100 patterns of 100 keys, flattened vs nested
+    std::vector<Sequence> patterns(100);
+    for (auto& p : patterns) {
+        for (int i = 0; i < 100; ++i)
+            p << Sine(175) * ASR(0.005, 0.01, 0.005) << 0.005;
+    }
+    tic();
+    Sequence flat;
+    for (int r = 0; r < 10; ++r) {
+        for (auto p : patterns)
+            flat.push(std::move(p));
+    }
+    double tFlat = toc();
+    tic();
+    Sequence nested;
+    for (int r = 0; r < 10; ++r) {
+        for (auto& p : patterns)
+            nested.pushNested(p);
+    }
+    double tNested = toc();
+    std::cout << std::endl;
+    std::cout << " Benchmark: Composition" << std::endl;
+    std::cout << " Flattened: " << tFlat << " s (" << flat.keyCount() << " keys)" << std::endl;
+    std::cout << " Nested:    " << tNested << " s (" << nested.keyCount() << " keys)" << std::endl;
+    std::cout << " Samples:   " << flat.sample(12.345) << " / " << nested.sample(12.345) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include "benchmark.hpp"
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace tact;
+
+// Computes spatial gains for a 32x32 array of 1024 channels as a target circles the array, once
+// by visiting every channel and once through a SpatialIndex that only visits channels near the
+// target plus those that just left it. Each update corresponds to one 32 frame control block.
+// Then mixes 32 moving sources into the array, as the Session does for Spatializer sources, and
+// evaluates a 3D array through an ellipsoidal kernel with gains computed one channel at a time and
+// as one batch.
+
+int main()
+{
+    const int side = 32;
+    const int n = 100000;
+    const double radius = 0.1;
+    Curve rollOff = Curves::Smoothstep();
+
+    std::vector<double> x, y;
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            x.push_back(c / (side - 1.0));
+            y.push_back(r / (side - 1.0));
+        }
+    }
+    int channels = (int)x.size();
+
+    auto targetAt = [](int i, double& tx, double& ty) {
+        tx = 0.5 + 0.4 * std::cos(i * 1e-4);
+        ty = 0.5 + 0.4 * std::sin(i * 1e-4);
+    };
+
+    std::vector<double> gains(channels, 0);
+    double sum = 0;
+    tic();
+    for (int i = 0; i < n; ++i) {
+        double tx, ty;
+        targetAt(i, tx, ty);
+        for (int k = 0; k < channels; ++k) {
+            double dx = x[k] - tx, dy = y[k] - ty;
+            gains[k] = rollOff(1.0 - clamp01(std::sqrt(dx * dx + dy * dy) / radius));
+        }
+        sum += gains[i % channels];
+    }
+    display(toc(), n, sum, "Every Channel (1024)", 48000 / 32);
+
+    SpatialIndex index;
+    index.build(x, y);
+    std::vector<int> active(channels), nearby;
+    for (int k = 0; k < channels; ++k)
+        active[k] = k;
+    nearby.reserve(channels);
+    std::vector<double> indexed(channels, 1);
+    double maxError = 0;
+    sum = 0;
+    tic();
+    for (int i = 0; i < n; ++i) {
+        double tx, ty;
+        targetAt(i, tx, ty);
+        index.query(tx, ty, 0, radius, radius, radius, 0, 0, nearby);
+        for (auto& k : nearby) {
+            double dx = x[k] - tx, dy = y[k] - ty;
+            indexed[k] = rollOff(1.0 - clamp01(std::sqrt(dx * dx + dy * dy) / radius));
+        }
+        for (auto& k : active) {
+            if (!index.queried(k))
+                indexed[k] = 0;
+        }
+        std::swap(active, nearby);
+        sum += indexed[i % channels];
+    }
+    display(toc(), n, sum, "Spatial Index (1024)", 48000 / 32);
+
+    // the index must produce the same gains as visiting every channel
+    for (int i = 0; i < 1000; ++i) {
+        double tx, ty;
+        targetAt(i * 997, tx, ty);
+        index.query(tx, ty, 0, radius, radius, radius, 0, 0, nearby);
+        for (auto& k : nearby) {
+            double dx = x[k] - tx, dy = y[k] - ty;
+            indexed[k] = rollOff(1.0 - clamp01(std::sqrt(dx * dx + dy * dy) / radius));
+        }
+        for (auto& k : active) {
+            if (!index.queried(k))
+                indexed[k] = 0;
+        }
+        std::swap(active, nearby);
+        for (int k = 0; k < channels; ++k) {
+            double dx = x[k] - tx, dy = y[k] - ty;
+            double g = rollOff(1.0 - clamp01(std::sqrt(dx * dx + dy * dy) / radius));
+            maxError = std::max(maxError, std::abs(g - indexed[k]));
+        }
+    }
+    std::cout << std::endl << " Max Error: " << maxError << std::endl;
+
+    // 32 moving sources mixed into the array: each source is rendered once per block and added to
+    // the channels near it, rather than every channel sampling every source's Signal
+    const int sources = 32;
+    const int block = 32;
+    const int blocks = 48000 / block;
+    std::vector<Signal> signals;
+    for (int s = 0; s < sources; ++s)
+        signals.push_back(Sine(100 + 10 * s) * Sine(2 + s % 5));
+    std::vector<std::vector<float>> out(channels, std::vector<float>(block));
+    std::vector<double> t(block), b(block);
+    std::vector<float> f(block);
+    sum = 0;
+    tic();
+    for (int i = 0; i < blocks; ++i) {
+        for (auto& o : out)
+            std::fill(o.begin(), o.end(), 0.0f);
+        for (int s = 0; s < sources; ++s) {
+            double tx, ty;
+            targetAt(i * 50 + s * 2000, tx, ty);
+            for (int j = 0; j < block; ++j)
+                t[j] = (i * block + j) / 48000.0;
+            signals[s].sample(t.data(), b.data(), block);
+            for (int j = 0; j < block; ++j)
+                f[j] = (float)b[j];
+            index.query(tx, ty, 0, radius, radius, radius, 0, 0, nearby);
+            for (auto& k : nearby) {
+                double dx = x[k] - tx, dy = y[k] - ty;
+                float g = (float)rollOff(1.0 - clamp01(std::sqrt(dx * dx + dy * dy) / radius));
+                for (int j = 0; j < block; ++j)
+                    out[k][j] += g * f[j];
+            }
+        }
+        sum += out[i % channels][0];
+    }
+    display(toc(), blocks, sum, "32 Sources Mixed (1024)", 48000 / 32);
+
+    sum = 0;
+    tic();
+    for (int i = 0; i < blocks / 10; ++i) {
+        for (int k = 0; k < channels; ++k) {
+            for (int j = 0; j < block; ++j) {
+                double tj = (i * block + j) / 48000.0;
+                double v = 0;
+                for (int s = 0; s < sources; ++s) {
+                    double tx, ty;
+                    targetAt(i * 50 + s * 2000, tx, ty);
+                    double dx = x[k] - tx, dy = y[k] - ty;
+                    v += rollOff(1.0 - clamp01(std::sqrt(dx * dx + dy * dy) / radius)) * signals[s].sample(tj);
+                }
+                out[k][j] = (float)v;
+            }
+        }
+        sum += out[i % channels][0];
+    }
+    display(toc(), blocks / 10, sum, "32 Sources Per Channel (1024)", 48000 / 32);
+
+    // 16x16x4 array with a kernel twice as wide in x and half as deep in z
+    std::vector<double> z;
+    x.clear(); y.clear();
+    for (int l = 0; l < 4; ++l) {
+        for (int r = 0; r < 16; ++r) {
+            for (int c = 0; c < 16; ++c) {
+                x.push_back(c / 15.0);
+                y.push_back(r / 15.0);
+                z.push_back(l / 3.0);
+            }
+        }
+    }
+    const double kx = 2, ky = 1, kz = 0.5, r3 = 0.15;
+    index.build(x, y, z);
+    auto gainAt = [&](int k, double tx, double ty, double tz) {
+        double dx = (x[k] - tx) / kx, dy = (y[k] - ty) / ky, dz = (z[k] - tz) / kz;
+        return rollOff(1.0 - clamp01(std::sqrt(dx * dx + dy * dy + dz * dz) / r3));
+    };
+    std::vector<double> d(channels), g(channels);
+    maxError = 0;
+    sum = 0;
+    tic();
+    for (int i = 0; i < n; ++i) {
+        double tx, ty;
+        targetAt(i, tx, ty);
+        double tz = 0.5 + 0.5 * std::sin(i * 3e-4);
+        index.query(tx, ty, tz, r3 * kx, r3 * ky, r3 * kz, 0, 0, nearby);
+        for (auto& k : nearby)
+            indexed[k] = gainAt(k, tx, ty, tz);
+        sum += nearby.empty() ? 0 : indexed[nearby[0]];
+    }
+    display(toc(), n, sum, "3D Kernel Per Channel (1024)", 48000 / 32);
+
+    auto batch = [&](int i, double& tx, double& ty, double& tz) {
+        targetAt(i, tx, ty);
+        tz = 0.5 + 0.5 * std::sin(i * 3e-4);
+        index.query(tx, ty, tz, r3 * kx, r3 * ky, r3 * kz, 0, 0, nearby);
+        int m = (int)nearby.size();
+        for (int j = 0; j < m; ++j) {
+            int k = nearby[j];
+            double dx = (x[k] - tx) / kx, dy = (y[k] - ty) / ky, dz = (z[k] - tz) / kz;
+            d[j] = std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+        for (int j = 0; j < m; ++j)
+            g[j] = 1.0 - clamp01(d[j] / r3);
+        rollOff(g.data(), g.data(), m);
+        return m;
+    };
+    sum = 0;
+    tic();
+    for (int i = 0; i < n; ++i) {
+        double tx, ty, tz;
+        int m = batch(i, tx, ty, tz);
+        sum += m == 0 ? 0 : g[0];
+    }
+    display(toc(), n, sum, "3D Kernel Batched (1024)", 48000 / 32);
+
+    // the batch must agree with per channel evaluation, and the index must miss nothing audible
+    for (int i = 0; i < n; i += 100) {
+        double tx, ty, tz;
+        int m = batch(i, tx, ty, tz);
+        for (int j = 0; j < m; ++j)
+            maxError = std::max(maxError, std::abs(g[j] - gainAt(nearby[j], tx, ty, tz)));
+        for (int k = 0; k < channels; ++k) {
+            if (!index.queried(k))
+                maxError = std::max(maxError, gainAt(k, tx, ty, tz));
+        }
+    }
+    std::cout << std::endl << " Max Error: " << maxError << std::endl;
+
+    return 0;
+}
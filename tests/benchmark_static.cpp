@@ -0,0 +1,44 @@
+#include "benchmark.hpp"
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace tact;
+
+// Samples the same effect built from runtime Signals and from static (st) Signals in 256 frame
+// blocks, as the Session renders them. The runtime tree makes a virtual call per node per sample,
+// while the static expression is one type inlined into a single loop. Then checks that the static
+// effect saves as its runtime equivalent and loads back as an ordinary Signal.
+
+int main()
+{
+    const int n = 48000 * 60;
+
+    Signal dynamic = (Sine(175) * Sine(5) * 0.8 + 0.1 * Square(40)) * (1 - Ramp(0, 0.01)); 
+    Signal fixed   = (st::Sine<>(175) * st::Sine<>(5) * 0.8 + 0.1 * st::Square<>(40)) * (1 - st::Ramp(0, 0.01));
+
+    tic();
+    double sum = render(dynamic, n);
+    display(toc(), n, sum, "Runtime Signal", 48000);
+
+    tic();
+    sum = render(fixed, n);
+    display(toc(), n, sum, "Static Signal", 48000);
+
+    std::string buffer;
+    Signal loaded;
+    if (!Library::encodeSignal(fixed, buffer) || !Library::decodeSignal(loaded, buffer.data(), buffer.size())) {
+        std::cout << " Failed to save and load static Signal" << std::endl;
+        return 1;
+    }
+    double maxError = 0;
+    for (int i = 0; i < 48000; ++i) {
+        double ti = i / 4800.0;
+        maxError = std::max(maxError, std::abs(fixed.sample(ti) - dynamic.sample(ti)));
+        maxError = std::max(maxError, std::abs(loaded.sample(ti) - dynamic.sample(ti)));
+    }
+    std::cout << std::endl << " Loaded:    " << loaded.typeId().name() << std::endl;
+    std::cout << " Max Error: " << maxError << std::endl;
+
+    return maxError < 1e-9 ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#include <syntacts>
+#include <Tact/Udp.hpp>
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <thread>
+
+using namespace tact;
+
+// Loopback benchmark of the UDP control protocol. The transport test floods the server with
+// batches of target messages for an unregistered Spatializer, so only socket, parse and dispatch
+// costs are measured. The tracking test mimics a 1 kHz motion tracking rig driving a Spatializer.
+
+void waitForDrain(const UdpServer& server) {
+    std::size_t last = 0;
+    do {
+        last = server.getMessageCount();
+        sleep(0.1);
+    } while (server.getMessageCount() != last);
+}
+
+int main(int argc, char const *argv[])
+{
+    int port = argc > 1 ? std::atoi(argv[1]) : SYNTACTS_UDP_PORT + 1;
+    double duration = 2;
+
+    Session session;
+    if (session.open() != SyntactsError_NoError) {
+        std::cout << "Failed to open default device" << std::endl;
+        return 1;
+    }
+
+    Spatializer spatializer(&session);
+    spatializer.createGrid(1, session.getChannelCount());
+    spatializer.play(Sine(175));
+
+    UdpServer server(session, port);
+    if (server.start() != SyntactsError_NoError) {
+        std::cout << "Failed to start UDP server on port " << port << std::endl;
+        return 1;
+    }
+    server.addSpatializer(0, spatializer);
+
+    UdpClient client;
+    client.connect("127.0.0.1", port);
+
+    // transport throughput
+    const int perBatch = 128;
+    std::size_t sent = 0;
+    tic();
+    while (toc() < duration) {
+        for (int i = 0; i < perBatch; ++i)
+            client.setTarget(1, 0.5, 0.5);
+        client.send();
+        sent += perBatch;
+    }
+    double elapsed = toc();
+    waitForDrain(server);
+    std::size_t received = server.getMessageCount();
+    std::cout << std::endl;
+    std::cout << " Benchmark: Transport" << std::endl;
+    std::cout << " Sent:      " << sent / elapsed / 1000000 << " M msg/s" << std::endl;
+    std::cout << " Received:  " << received / elapsed / 1000000 << " M msg/s" << std::endl;
+    std::cout << " Dropped:   " << 100.0 * (sent - std::min(sent, received)) / sent << " %" << std::endl;
+
+    // 1 kHz tracking with a ping in every batch
+    std::vector<double> trips;
+    trips.reserve(static_cast<std::size_t>(duration * 1000));
+    double next = UdpClient::now();
+    std::uint32_t id = 0;
+    tic();
+    while (toc() < duration) {
+        while (UdpClient::now() < next)
+            std::this_thread::yield();
+        next += 0.001;
+        double x = 0.5 + 0.5 * std::sin(TWO_PI * toc());
+        client.setTime(UdpClient::now());
+        client.setTarget(0, x, 0.5);
+        client.ping(id++);
+        client.send();
+        std::uint32_t pid;
+        double trip;
+        if (client.receivePong(pid, trip, 0.01))
+            trips.push_back(trip);
+    }
+    // the server is the Session's only producer while running, so stop it before commanding the Session here
+    server.stop();
+    spatializer.stop();
+    std::sort(trips.begin(), trips.end());
+    std::cout << std::endl;
+    std::cout << " Benchmark: Tracking (1 kHz)" << std::endl;
+    std::cout << " Replies:   " << trips.size() << " / " << id << std::endl;
+    if (!trips.empty()) {
+        std::cout << " Median:    " << trips[trips.size() / 2] * 1000000 / 2 << " us (one way)" << std::endl;
+        std::cout << " P99:       " << trips[trips.size() * 99 / 100] * 1000000 / 2 << " us (one way)" << std::endl;
+    }
+    std::cout << " Scheduled: " << server.getLatency() * 1000 << " ms after send" << std::endl;
+
+    session.close();
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "benchmark.hpp"
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+using namespace tact;
+
+// Renders Square, Saw and Triangle Oscillators and their band-limited Wavetable equivalents
+// at 48 kHz in 256 frame blocks, then measures how much of a 2.9 kHz tone's energy aliases
+// (falls outside its harmonics below the 24 kHz Nyquist frequency).
+
+/// Returns the fraction of a one second render's energy that isn't at harmonics of hertz.
+double aliasing(const Signal& signal, double hertz) {
+    const int n = 48000;
+    std::vector<double> t(n), b(n);
+    for (int i = 0; i < n; ++i)
+        t[i] = i / 48000.0;
+    signal.sample(t.data(), b.data(), n);
+    double total = 0, harmonics = 0;
+    for (int i = 0; i < n; ++i)
+        total += b[i] * b[i];
+    for (int k = 1; k * hertz < 24000; ++k) {
+        double re = 0, im = 0, w = TWO_PI * k * hertz / 48000.0;
+        for (int i = 0; i < n; ++i) {
+            re += b[i] * std::cos(w * i);
+            im += b[i] * std::sin(w * i);
+        }
+        harmonics += 2 * (re * re + im * im) / n;
+    }
+    return (total - harmonics) / total;
+}
+
+int main()
+{
+    const int n = 48000 * 60;
+    const double hertz = 2900;
+    std::vector<std::pair<std::string, Signal>> oscillators = {
+        {"Sine",               Sine(hertz)},
+        {"Wavetable Sine",     Wavetable(Wavetable::Shape::Sine, hertz)},
+        {"Square",             Square(hertz)},
+        {"Wavetable Square",   Wavetable(Wavetable::Shape::Square, hertz)},
+        {"Saw",                Saw(hertz)},
+        {"Wavetable Saw",      Wavetable(Wavetable::Shape::Saw, hertz)},
+        {"Triangle",           Triangle(hertz)},
+        {"Wavetable Triangle", Wavetable(Wavetable::Shape::Triangle, hertz)}
+    };
+    for (auto& o : oscillators) {
+        tic();
+        double sum = render(o.second, n);
+        display(toc(), n, sum, o.first);
+        std::cout << " Aliasing:  " << aliasing(o.second, hertz) << std::endl;
+    }
+    return 0;
+}
@@ -417,11 +417,71 @@ namespace Syntacts
             Dll.Spatializer_play(handle, signal.handle);
         }
 
-        /// <summary>Stop all Signals playing in the Spatializer.</summary>
+        /// <summary>Stop all Signals playing in the Spatializer, including sources.</summary>
         public void Stop() {
             Dll.Spatializer_stop(handle);
         }
 
+        /// <summary>Add a source that plays a Signal at its own position, mixed into the Spatializer channels. Returns the source id, or a negative error code.</summary>
+        public int AddSource(Signal signal, double x = 0.5, double y = 0.5) {
+            return Dll.Spatializer_addSource(handle, signal.handle, x, y);
+        }
+
+        /// <summary>Play a new Signal on a source.</summary>
+        public void PlaySource(int source, Signal signal) {
+            Dll.Spatializer_playSource(handle, source, signal.handle);
+        }
+
+        /// <summary>Remove a source and stop its Signal.</summary>
+        public void RemoveSource(int source) {
+            Dll.Spatializer_removeSource(handle, source);
+        }
+
+        /// <summary>Set the position of a source.</summary>
+        public void SetSourcePosition(int source, double x, double y = 0) {
+            Dll.Spatializer_setSourcePosition(handle, source, x, y);
+        }
+
+        /// <summary>Set the radius of a source.</summary>
+        public void SetSourceRadius(int source, double r) {
+            Dll.Spatializer_setSourceRadius(handle, source, r);
+        }
+
+        /// <summary>Set the volume of a source.</summary>
+        public void SetSourceVolume(int source, double volume) {
+            Dll.Spatializer_setSourceVolume(handle, source, volume);
+        }
+
+        /// <summary>Move the target along x(t) and y(t) Signals evaluated by the audio thread, overriding the target position until cleared.</summary>
+        public void SetTrajectory(Signal x, Signal y) {
+            Dll.Spatializer_setTrajectory1(handle, x.handle, y.handle);
+        }
+
+        /// <summary>Move the target along x(t) and y(t) and vary its radius along r(t), evaluated by the audio thread.</summary>
+        public void SetTrajectory(Signal x, Signal y, Signal r) {
+            Dll.Spatializer_setTrajectory2(handle, x.handle, y.handle, r.handle);
+        }
+
+        /// <summary>Return the target to its set position.</summary>
+        public void ClearTrajectory() {
+            Dll.Spatializer_clearTrajectory(handle);
+        }
+
+        /// <summary>Move a source along x(t) and y(t) Signals evaluated by the audio thread, overriding its position until cleared.</summary>
+        public void SetSourceTrajectory(int source, Signal x, Signal y) {
+            Dll.Spatializer_setSourceTrajectory1(handle, source, x.handle, y.handle);
+        }
+
+        /// <summary>Move a source along x(t) and y(t) and vary its radius along r(t), evaluated by the audio thread.</summary>
+        public void SetSourceTrajectory(int source, Signal x, Signal y, Signal r) {
+            Dll.Spatializer_setSourceTrajectory2(handle, source, x.handle, y.handle, r.handle);
+        }
+
+        /// <summary>Return a source to its set position.</summary>
+        public void ClearSourceTrajectory(int source) {
+            Dll.Spatializer_clearSourceTrajectory(handle, source);
+        }
+
         /// <summary>Explicitly update the pitch/volume of all channels in the Spatializer.</summary>
         public void Update() {
             Dll.Spatializer_update(handle);
@@ -484,11 +544,42 @@ namespace Syntacts
             set { Dll.Spatializer_setWrap(handle, value.x, value.y); }
         }
 
+        /// <summary>Number of nearest channels the target is panned between at constant power. A value of 0 uses the radius and roll-off instead.</summary>
+        public int nearest {
+            get { return Dll.Spatializer_getNearest(handle); }
+            set { Dll.Spatializer_setNearest(handle, value); }
+        }
+
+        /// <summary>Sets the scale of the target kernel along each axis, stretching the radius into an ellipsoid.</summary>
+        public void SetKernel(double x, double y, double z = 1) {
+            Dll.Spatializer_setKernel(handle, x, y, z);
+        }
+
+        /// <summary>Sets the calibration gain of a channel.</summary>
+        public void SetCalibration(int channel, double gain) {
+            Dll.Spatializer_setCalibration(handle, channel, gain);
+        }
+
+        /// <summary>Gets the calibration gain of a channel.</summary>
+        public double GetCalibration(int channel) {
+            return Dll.Spatializer_getCalibration(handle, channel);
+        }
+
         /// <summary>The number of channels in the Spatializer.</summary>
         public int channelCount {
             get { return Dll.Spatializer_getChannelCount(handle); }
         }
 
+        /// <summary>The number of sources in the Spatializer.</summary>
+        public int sourceCount {
+            get { return Dll.Spatializer_getSourceCount(handle); }
+        }
+
+        /// <summary>True if the target is following a trajectory.</summary>
+        public bool hasTrajectory {
+            get { return Dll.Spatializer_hasTrajectory(handle); }
+        }
+
         /// <summary>The global volume of the Spatializer.</summary>
         public double volume {
             get { return Dll.Spatializer_getVolume(handle); }
@@ -545,6 +636,12 @@ namespace Syntacts
             get { return Dll.Signal_length(handle); }
         }
 
+        /// <summary>An upper bound on the magnitude of the Signal's samples, or infinity if unknown.</summary>
+        public double peak
+        {
+            get { return Dll.Signal_peak(handle); }
+        }
+
         /// <summary>The Signal will be scaled by this amount when sampled.</summary>
         public double gain
         {
@@ -781,6 +878,16 @@ namespace Syntacts
         public Expression(string expr) :
             base(Dll.Expression_create(expr))
         { }
+
+        /// <summary>Sets a named variable usable in the expression, adding it if new.</summary>
+        public bool SetVariable(string name, double value) {
+            return Dll.Expression_setVariable(handle, name, value);
+        }
+
+        /// <summary>Gets the value of a named variable, or 0 if it does not exist.</summary>
+        public double GetVariable(string name) {
+            return Dll.Expression_getVariable(handle, name);
+        }
     }
 
     /// <summary>A Signal defined by an array of recorded samples (used internally for Library.ImportSignal).</summary>
@@ -818,6 +925,14 @@ namespace Syntacts
         { }
     }
 
+    /// <summary>A Signal which evaluates another Signal at a control rate and interpolates between, for envelopes and LFOs.</summary>
+    public class ControlRate : Signal
+    {
+        public ControlRate(Signal signal, double rate = 1000) :
+            base(Dll.ControlRate_create(signal.handle, rate))
+        { }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // ENVELOPE
     ///////////////////////////////////////////////////////////////////////////
@@ -954,6 +1069,51 @@ namespace Syntacts
         { }
     }
 
+    /// <summary>A sine wave whose frequency changes linearly, computed in closed form.</summary>
+    public class Chirp : Signal
+    {
+        public Chirp(double initial, double rate) :
+            base(Dll.Chirp_create(initial, rate))
+        { }
+    }
+
+    /// <summary>A sine carrier frequency modulated by a sine, computed in closed form.</summary>
+    public class FmSine : Signal
+    {
+        public FmSine(double frequency, double modulation, double index = 2.0) :
+            base(Dll.FmSine_create(frequency, modulation, index))
+        { }
+    }
+
+    /// <summary>Shapes of a Wavetable Oscillator.</summary>
+    public enum WavetableShape {
+        Sine     = 0, ///< sine wave
+        Square   = 1, ///< band-limited square wave
+        Saw      = 2, ///< band-limited saw wave
+        Triangle = 3  ///< band-limited triangle wave
+    }
+
+    /// <summary>An Oscillator that reads band-limited tables, selected by frequency so it doesn't alias.</summary>
+    public class Wavetable : Signal
+    {
+        public Wavetable(WavetableShape shape, double hertz) :
+            base(Dll.Wavetable_create1((int)shape, hertz))
+        { }
+
+        public Wavetable(WavetableShape shape, Signal x) :
+            base(Dll.Wavetable_create2((int)shape, x.handle))
+        { }
+
+        /// <summary>Constructs a Wavetable from one cycle of a finite Signal sampled over its length.</summary>
+        public Wavetable(Signal cycle, double hertz) :
+            base(Dll.Wavetable_create3(cycle.handle, hertz))
+        { }
+
+        public Wavetable(Signal cycle, Signal x) :
+            base(Dll.Wavetable_create4(cycle.handle, x.handle))
+        { }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // LIBRARY
     ///////////////////////////////////////////////////////////////////////////
@@ -965,7 +1125,8 @@ namespace Syntacts
         WAV = 2,  ///< WAV audio file format
         AIFF = 3, ///< AIFF audio file format
         CSV = 4,  ///< comman-separated-value format,
-        JSON = 5  ///< human readable serialized format
+        JSON = 5, ///< human readable serialized format
+        RAW = 6   ///< headerless 32-bit float PCM (memory-mapped on import)
     }
 
     /// <summary>Contains Syntacts Library functions.<summary>
@@ -996,7 +1157,7 @@ namespace Syntacts
         }
 
         /// <summary>Imports a Signal of a specific file format.<summary>
-        public static bool ImportSignal(out Signal signal, string filePath, FileFormat format = FileFormat.Auto, int sampleRate = 48000) {
+        public static bool ImportSignal(out Signal signal, string filePath, FileFormat format = FileFormat.Auto, int sampleRate = 0) {
             signal = new Signal(Dll.Library_importSignal(filePath, (int)format, sampleRate));
             if (signal.handle == Handle.Zero)
                 return false;
@@ -1139,6 +1300,18 @@ namespace Syntacts
         public static extern void Spatializer_setWrap(Handle spat, double x, double y);
         [DllImport("syntacts_c")]
         public static extern void Spatializer_getWrap(Handle spat, ref double x, ref double y);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_setCalibration(Handle spat, int channel, double gain);
+        [DllImport("syntacts_c")]
+        public static extern double Spatializer_getCalibration(Handle spat, int channel);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_setKernel(Handle spat, double x, double y, double z);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_getKernel(Handle spat, ref double x, ref double y, ref double z);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_setNearest(Handle spat, int k);
+        [DllImport("syntacts_c")]
+        public static extern int Spatializer_getNearest(Handle spat);
 
         [DllImport("syntacts_c")]
         public static extern bool Spatializer_createGrid(Handle spat, int rows, int cols);
@@ -1164,6 +1337,35 @@ namespace Syntacts
         [DllImport("syntacts_c")]
         public static extern double Spatializer_getPitch(Handle spat);
 
+        [DllImport("syntacts_c")]
+        public static extern int Spatializer_addSource(Handle spat, Handle signal, double x, double y);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_playSource(Handle spat, int source, Handle signal);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_removeSource(Handle spat, int source);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_setSourcePosition(Handle spat, int source, double x, double y);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_setSourceRadius(Handle spat, int source, double r);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_setSourceVolume(Handle spat, int source, double volume);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_setSourceTrajectory1(Handle spat, int source, Handle x, Handle y);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_setSourceTrajectory2(Handle spat, int source, Handle x, Handle y, Handle r);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_clearSourceTrajectory(Handle spat, int source);
+        [DllImport("syntacts_c")]
+        public static extern int Spatializer_getSourceCount(Handle spat);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_setTrajectory1(Handle spat, Handle x, Handle y);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_setTrajectory2(Handle spat, Handle x, Handle y, Handle r);
+        [DllImport("syntacts_c")]
+        public static extern void Spatializer_clearTrajectory(Handle spat);
+        [DllImport("syntacts_c")]
+        public static extern bool Spatializer_hasTrajectory(Handle spat);
+
         [DllImport("syntacts_c")]
         public static extern void Spatializer_autoUpdate(Handle spat, bool enable);
         [DllImport("syntacts_c")]
@@ -1178,6 +1380,8 @@ namespace Syntacts
         [DllImport("syntacts_c")]
         public static extern double Signal_length(Handle signal);
         [DllImport("syntacts_c")]
+        public static extern double Signal_peak(Handle signal);
+        [DllImport("syntacts_c")]
         public static extern void Signal_setGain(Handle signal, double gain);
         [DllImport("syntacts_c")]
         public static extern double Signal_getGain(Handle signal);
@@ -1252,6 +1456,10 @@ namespace Syntacts
         public static extern Handle Noise_create();
         [DllImport("syntacts_c", CallingConvention = CallingConvention.Cdecl)]
         public static extern Handle Expression_create(string expr);
+        [DllImport("syntacts_c", CallingConvention = CallingConvention.Cdecl)]
+        public static extern bool Expression_setVariable(Handle expr, string name, double value);
+        [DllImport("syntacts_c", CallingConvention = CallingConvention.Cdecl)]
+        public static extern double Expression_getVariable(Handle expr, string name);
         [DllImport("syntacts_c")]
         public static extern Handle Samples_create(float[] samples, int nSamples, double sampleRate);
 
@@ -1261,6 +1469,8 @@ namespace Syntacts
         public static extern Handle Stretcher_create(Handle signal, double factor);
         [DllImport("syntacts_c")]
         public static extern Handle Reverser_create(Handle signal);
+        [DllImport("syntacts_c")]
+        public static extern Handle ControlRate_create(Handle signal, double rate);
 
         [DllImport("syntacts_c")]
         public static extern Handle Envelope_create(double duration, double amp);
@@ -1311,6 +1521,19 @@ namespace Syntacts
 
         [DllImport("syntacts_c")]
         public static extern Handle Pwm_create(double frequency, double dutyCycle);
+        [DllImport("syntacts_c")]
+        public static extern Handle Chirp_create(double initial, double rate);
+        [DllImport("syntacts_c")]
+        public static extern Handle FmSine_create(double frequency, double modulation, double index);
+
+        [DllImport("syntacts_c")]
+        public static extern Handle Wavetable_create1(int shape, double hertz);
+        [DllImport("syntacts_c")]
+        public static extern Handle Wavetable_create2(int shape, Handle x);
+        [DllImport("syntacts_c")]
+        public static extern Handle Wavetable_create3(Handle cycle, double hertz);
+        [DllImport("syntacts_c")]
+        public static extern Handle Wavetable_create4(Handle cycle, Handle x);
 
         [DllImport("syntacts_c", CallingConvention = CallingConvention.Cdecl)]
         public static extern bool Library_saveSignal(Handle signal, string name);